@@ -58,6 +58,80 @@ uint8_t field_tester_pckg[32];
 /** Flag for GNSS readings active */
 bool gnss_active = false;
 
+/** Timer events waiting for timer_task, the timer callbacks only set the flags */
+volatile uint8_t timer_events = 0;
+
+/**
+ * @brief Timer callback for periodic sending, the test is started in the loop
+ *
+ */
+void send_timer_cb(void *)
+{
+	timer_events |= EVENT_SEND;
+}
+
+/**
+ * @brief Timer callback for the display handler, the display is drawn in the loop
+ *
+ */
+void display_timer_cb(void *)
+{
+	timer_events |= EVENT_DISPLAY;
+}
+
+/**
+ * @brief Timer callback for the display saver, the display is switched off in the loop
+ *
+ */
+void saver_timer_cb(void *)
+{
+	timer_events |= EVENT_SAVER;
+}
+
+/**
+ * @brief Timer callback for the GNSS acquisition, the GNSS is polled in the loop
+ *
+ */
+void gnss_timer_cb(void *)
+{
+	timer_events |= EVENT_GNSS;
+}
+
+/**
+ * @brief Background task, handles the timer events
+ *     Display, I2C bus and radio are only used from the loop,
+ *     so the framebuffer and the I2C transfers need no locking
+ *
+ */
+void timer_task(void)
+{
+	noInterrupts();
+	uint8_t events = timer_events;
+	timer_events = 0;
+	interrupts();
+
+	if ((events & EVENT_GNSS) && gnss_active)
+	{
+		gnss_handler(NULL);
+	}
+	if (events & EVENT_DISPLAY)
+	{
+		handle_display(&display_reason);
+	}
+	if (events & EVENT_SEND)
+	{
+		send_packet(NULL);
+	}
+	if (events & EVENT_SAVER)
+	{
+		oled_saver(NULL);
+	}
+	if (events & EVENT_BUTTON)
+	{
+		handle_button();
+	}
+}
+
 /**
  * @brief Send a LoRaWAN packet
  *
@@ -76,6 +150,46 @@ void send_packet(void *data)
 		{
 			if (!gnss_active)
 			{
+				bool moved = acc_check_moved();
+				// Device is still in the cell of the last good fix, skip a covered cell before the GNSS is powered up
+				if (!moved && !forced_tx && coverage_skip(g_last_lat, g_last_long))
+				{
+					if (has_oled && !g_settings_ui)
+					{
+						oled_clear();
+						oled_write_header((char *)"RAK Field Tester");
+						oled_add_line((char *)"Cell covered, skip test");
+					}
+					tx_active = false;
+					return;
+				}
+
+				// Device did not move since the last good fix, reuse the location
+				if (!moved && gnss_reuse_fix())
+				{
+					MYLOG("APP", "No motion, reuse last location");
+					forced_tx = false;
+					// No acquisition until the device moves, the GNSS can sleep
+					gnss_park();
+					if (has_oled && !g_settings_ui)
+					{
+						oled_clear();
+						oled_write_header((char *)"RAK Field Tester");
+						oled_add_line((char *)"Not moved, reuse location");
+					}
+					// Always send confirmed packet to make sure a reply is received
+					if (!api.lorawan.send(g_solution_data.getSize(), g_solution_data.getBuffer(), 1, true, 7))
+					{
+						MYLOG("APP", "LoRaWAN send returned error");
+						tx_active = false;
+					}
+					return;
+				}
+
+				// Arm motion detection, any motion from now on requires a new acquisition
+				acc_rearm();
+				gnss_wake();
+
 				if (has_oled && !g_settings_ui)
 				{
 					oled_clear();
@@ -89,9 +203,22 @@ void send_packet(void *data)
 					digitalWrite(WB_IO2, HIGH);
 				}
 
+				// Start a new acquisition, the budget is learned from the previous ones
+				gnss_acq_start();
+
 				// Check if we already have a sufficient location fix
 				if (poll_gnss())
 				{
+					if (!forced_tx && coverage_skip(g_last_lat, g_last_long))
+					{
+						if (has_oled && !g_settings_ui)
+						{
+							oled_add_line((char *)"Cell covered, skip test");
+						}
+						tx_active = false;
+						return;
+					}
+					forced_tx = false;
 					// if (has_oled && !g_settings_ui)
 					// {
 						// oled_clear();
@@ -114,12 +241,6 @@ void send_packet(void *data)
 					// Set flag for GNSS active to avoid retrigger */
 					gnss_active = true;
 					g_solution_data.reset();
-					check_gnss_counter = 0;
-					// Max location aquisition time is half of send frequency
-					check_gnss_max_try = g_custom_parameters.send_interval / 2 / 2500;
-					// Reset satellites check values
-					max_sat = 0;
-					max_sat_unchanged = 0;
 					// Start the timer
 					api.system.timer.start(RAK_TIMER_3, 2500, NULL);
 				}
@@ -171,28 +292,20 @@ void send_packet(void *data)
 				MYLOG("APP", "Send packet");
 				oled_add_line((char *)"Start sending");
 
-				// Check DR
-				uint8_t new_dr = get_min_dr(api.lorawan.band.get(), g_custom_parameters.custom_packet_len);
-				MYLOG("UPLINK", "Get DR for packet len %d returned %d, current is %d", g_custom_parameters.custom_packet_len, new_dr, api.lorawan.dr.get());
-				if (new_dr <= api.lorawan.dr.get())
-				{
-					MYLOG("UPLINK", "Possible Datarate is ok or smaller than current");
-				}
-				else
+				// Check DR, usually already done after join or on the last send
+				if (prepare_tx())
 				{
-					api.lorawan.dr.set(new_dr);
-					delay(500);
-					MYLOG("UPLINK", "Datarate changed to %d", api.lorawan.dr.get());
 					if (has_oled && !g_settings_ui)
 					{
 						oled_add_line((char *)"Packet too large!");
-						sprintf(line_str, "New DR%d", new_dr);
+						sprintf(line_str, "New DR%d", api.lorawan.dr.get());
 						oled_add_line(line_str);
 					}
-					MYLOG("UPLINK", "Datarate changed to %d", api.lorawan.dr.get());
 				}
 				// Always send confirmed packet to make sure a reply is received
-				if (!api.lorawan.send(g_custom_parameters.custom_packet_len, g_custom_parameters.custom_packet, 2, true, 7))
+				uint16_t packet_len;
+				uint8_t *packet = payload_next(&packet_len);
+				if (!api.lorawan.send(packet_len, packet, 2, true, 7))
 				{
 					tx_active = false;
 					MYLOG("APP", "LoRaWAN send returned error");
@@ -202,6 +315,10 @@ void send_packet(void *data)
 			{
 				tx_active = false;
 				MYLOG("APP", "Not joined, don't send packet");
+				if (has_oled && !g_settings_ui)
+				{
+					oled_display();
+				}
 			}
 		}
 		else
@@ -211,12 +328,73 @@ void send_packet(void *data)
 			oled_add_line((char *)"Start sending");
 
 			// Always send with CAD
-			api.lora.psend(g_custom_parameters.custom_packet_len, g_custom_parameters.custom_packet, true);
+			uint16_t packet_len;
+			uint8_t *packet = payload_next(&packet_len);
+			api.lora.psend(packet_len, packet, true);
 			tx_active = true;
 		}
 	}
 }
 
+/**
+ * @brief (Re)start the periodic send timer
+ *     In Field Tester mode the interval follows the motion of the device
+ *
+ */
+void start_send_timer(void)
+{
+	api.system.timer.stop(RAK_TIMER_0);
+	uint32_t interval = acc_adjust_interval(g_custom_parameters.send_interval);
+	if (interval != 0)
+	{
+		MYLOG("APP", "Send interval %ld ms", interval);
+		api.system.timer.start(RAK_TIMER_0, interval, NULL);
+	}
+}
+
+/**
+ * @brief Prepare the datarate for the custom packet
+ *     Called after join and before each send. The DR is only changed if
+ *     the current DR is too low for the packet, the check is skipped if
+ *     region and packet length did not change.
+ *
+ * @return true if the DR was changed
+ */
+bool prepare_tx(void)
+{
+	/** Region the minimum DR was calculated for */
+	static uint16_t prepared_band = 0xFFFF;
+	/** Packet length the minimum DR was calculated for */
+	static uint16_t prepared_len = 0xFFFF;
+	/** Minimum DR for region and packet length */
+	static uint8_t prepared_dr = 0;
+
+	if (!api.lorawan.nwm.get() || !api.lorawan.njs.get())
+	{
+		return false;
+	}
+
+	uint16_t band = api.lorawan.band.get();
+	// With the payload generator the DR must fit the longest packet
+	uint16_t packet_len = payload_max_len();
+	if ((band != prepared_band) || (packet_len != prepared_len))
+	{
+		prepared_dr = get_min_dr(band, packet_len);
+		prepared_band = band;
+		prepared_len = packet_len;
+		MYLOG("UPLINK", "Get DR for packet len %d returned %d, current is %d", prepared_len, prepared_dr, api.lorawan.dr.get());
+	}
+	if (prepared_dr <= api.lorawan.dr.get())
+	{
+		return false;
+	}
+	api.lorawan.dr.set(prepared_dr);
+	status_invalidate();
+	delay(500);
+	MYLOG("UPLINK", "Datarate changed to %d", api.lorawan.dr.get());
+	return true;
+}
+
 /**
  * @brief Display handler
  *
@@ -311,12 +489,17 @@ void handle_display(void *reason)
 			oled_write_line(4, 64, line_str);
 			oled_display();
 		}
-		Serial.println("LPW P2P mode");
-		Serial.printf("Packet # %d RSSI %d SNR %d\n", packet_num, last_rssi, last_snr);
-		Serial.printf("F %.3f SF %d BW %d\n",
-					  (float)api.lora.pfreq.get() / 1000000.0,
-					  api.lora.psf.get(),
-					  (api.lora.pbw.get() + 1) * 125);
+		if (!g_custom_parameters.telemetry)
+		{
+			Serial.println("LPW P2P mode");
+			Serial.printf("Packet # %d RSSI %d SNR %d\n", packet_num, last_rssi, last_snr);
+			Serial.printf("F %.3f SF %d BW %d\n",
+						  (float)api.lora.pfreq.get() / 1000000.0,
+						  api.lora.psf.get(),
+						  (api.lora.pbw.get() + 1) * 125);
+		}
+		log_result(1, last_rssi, last_snr, 0, 0);
+		graph_add(last_rssi, last_snr);
 	}
 	// else if (disp_reason[0] == 2)
 	// {
@@ -428,6 +611,11 @@ void handle_display(void *reason)
 	else if (disp_reason[0] == 5)
 	{
 		// MYLOG("APP", "JOIN_SUCCESS %d\n", disp_reason[0]);
+		// Set the DR for the custom packet before the first send
+		if (g_custom_parameters.test_mode == MODE_LINKCHECK)
+		{
+			prepare_tx();
+		}
 		if (has_oled && !g_settings_ui)
 		{
 			switch (g_custom_parameters.test_mode)
@@ -544,9 +732,17 @@ void handle_display(void *reason)
 			}
 			oled_display();
 		}
-		Serial.printf("LinkCheck %s\n", link_check_state == 0 ? "OK" : "NOK");
-		Serial.printf("Packet # %d RSSI %d SNR %d\n", packet_num, last_rssi, last_snr);
-		Serial.printf("GW # %d Demod Margin %d\n", link_check_gateways, link_check_demod_margin);
+		if (!g_custom_parameters.telemetry)
+		{
+			Serial.printf("LinkCheck %s\n", link_check_state == 0 ? "OK" : "NOK");
+			Serial.printf("Packet # %d RSSI %d SNR %d\n", packet_num, last_rssi, last_snr);
+			Serial.printf("GW # %d Demod Margin %d\n", link_check_gateways, link_check_demod_margin);
+		}
+		log_result(4, last_rssi, last_snr, link_check_demod_margin, link_check_gateways);
+		if (link_check_state == 0)
+		{
+			graph_add(last_rssi, last_snr);
+		}
 	}
 	else if (display_reason == 6)
 	{
@@ -555,9 +751,20 @@ void handle_display(void *reason)
 		int16_t min_distance = field_tester_pckg[3] * 250;
 		int16_t max_distance = field_tester_pckg[4] * 250;
 		int8_t num_gateways = field_tester_pckg[5];
-		Serial.printf("+EVT:FieldTester %d gateways\n", num_gateways);
-		Serial.printf("+EVT:RSSI min %d max %d\n", min_rssi, max_rssi);
-		Serial.printf("+EVT:Distance min %d max %d\n", min_distance, max_distance);
+		if (!g_custom_parameters.telemetry)
+		{
+			Serial.printf("+EVT:FieldTester %d gateways\n", num_gateways);
+			Serial.printf("+EVT:RSSI min %d max %d\n", min_rssi, max_rssi);
+			Serial.printf("+EVT:Distance min %d max %d\n", min_distance, max_distance);
+		}
+		log_result(6, max_rssi, last_snr, 0, num_gateways);
+		graph_add(max_rssi, last_snr);
+
+		// Collect the result in the coverage grid
+		if (g_custom_parameters.location_on)
+		{
+			coverage_add(g_last_lat, g_last_long, max_rssi, num_gateways);
+		}
 
 		if (has_oled && !g_settings_ui)
 		{
@@ -584,7 +791,7 @@ void handle_display(void *reason)
 				oled_write_line(2, 80, line_str);
 				sprintf(line_str, "%d", max_distance);
 				oled_write_line(3, 80, line_str);
-				sprintf(line_str, "L %.6f:%.6f", g_last_lat, g_last_long);
+				fmt_location(line_str, "L ", ":", g_last_lat, g_last_long, 6);
 				oled_write_line(4, 0, line_str);
 			}
 			else
@@ -600,7 +807,11 @@ void handle_display(void *reason)
 	}
 	else if (display_reason == 7)
 	{
-		Serial.printf("+EVT:FieldTester no downlink\n");
+		if (!g_custom_parameters.telemetry)
+		{
+			Serial.printf("+EVT:FieldTester no downlink\n");
+		}
+		log_result(7, 0, 0, 0, 0);
 
 		if (has_oled && !g_settings_ui)
 		{
@@ -609,14 +820,17 @@ void handle_display(void *reason)
 
 			sprintf(line_str, "No Downlink received");
 			oled_write_line(0, 0, line_str);
-			sprintf(line_str, "L %.6f:%.6f", g_last_lat, g_last_long);
+			fmt_location(line_str, "L ", ":", g_last_lat, g_last_long, 6);
 			oled_write_line(4, 0, line_str);
 			oled_display();
 		}
 	}
 	else if (display_reason == 8)
 	{
-		Serial.printf("+EVT:P2P TX finished\n");
+		if (!g_custom_parameters.telemetry)
+		{
+			Serial.printf("+EVT:P2P TX finished\n");
+		}
 		tx_active = false;
 
 		if (has_oled && !g_settings_ui)
@@ -640,6 +854,7 @@ void handle_display(void *reason)
  */
 void join_cb_lpw(int32_t status)
 {
+	status_invalidate();
 	if (status != 0)
 	{
 		display_reason = 3;
@@ -729,6 +944,8 @@ void recv_cb_lpw(SERVICE_LORA_RECEIVE_T *data)
  */
 void send_cb_lpw(int32_t status)
 {
+	// ADR might have changed the datarate
+	status_invalidate();
 	if (status != RAK_LORAMAC_STATUS_OK)
 	{
 		tx_active = false;
@@ -792,6 +1009,9 @@ void setup(void)
 	sprintf(line_str, "RUI3_Tester_V%d.%d.%d", SW_VERSION_0, SW_VERSION_1, SW_VERSION_2);
 	api.system.firmwareVersion.set(line_str);
 
+	// First battery value for the header
+	init_battery();
+
 	// Check if OLED is available
 	Wire.begin();
 	has_oled = init_oled();
@@ -799,6 +1019,7 @@ void setup(void)
 	{
 		sprintf(line_str, "RAK Signal Meter");
 		oled_write_header(line_str);
+		oled_display();
 	}
 
 	digitalWrite(LED_GREEN, HIGH);
@@ -854,6 +1075,42 @@ void setup(void)
 	{
 		MYLOG("APP", "Failed to initialize Custom Packet AT command");
 	}
+	if (!init_send_distance_at())
+	{
+		MYLOG("APP", "Failed to initialize Send Distance AT command");
+	}
+	if (!init_grid_at())
+	{
+		MYLOG("APP", "Failed to initialize Coverage Grid AT command");
+	}
+	if (!init_skip_covered_at())
+	{
+		MYLOG("APP", "Failed to initialize Skip Covered AT command");
+	}
+	if (!init_log_at())
+	{
+		MYLOG("APP", "Failed to initialize Result Log AT command");
+	}
+	if (!init_telemetry_at())
+	{
+		MYLOG("APP", "Failed to initialize Telemetry AT command");
+	}
+	if (!init_oled_at())
+	{
+		MYLOG("APP", "Failed to initialize Display AT command");
+	}
+	if (!init_instant_tx_at())
+	{
+		MYLOG("APP", "Failed to initialize Instant TX AT command");
+	}
+	if (!init_profile_at())
+	{
+		MYLOG("APP", "Failed to initialize Profile AT command");
+	}
+	if (!init_stats_at())
+	{
+		MYLOG("APP", "Failed to initialize Stats AT command");
+	}
 
 	// Get saved custom settings
 	if (!get_at_setting())
@@ -861,14 +1118,24 @@ void setup(void)
 		MYLOG("APP", "Failed to read saved custom settings");
 	}
 
+	// Find the end of the result log
+	init_log();
+
 	// Initialize Button
 	if (!buttonInit())
 	{
 		MYLOG("APP", "Failed to initialize button");
 	}
 
-	// Initialize ACC (set to sleep as default)
-	init_acc(false);
+	// Initialize ACC (motion detection in Field Tester mode, otherwise set to sleep)
+	if (g_custom_parameters.test_mode == MODE_FIELDTESTER)
+	{
+		g_has_acc = init_acc(true);
+	}
+	else
+	{
+		init_acc(false);
+	}
 
 	// Initialize GNSS (set to sleep as default)
 	if (g_custom_parameters.test_mode == 3)
@@ -882,6 +1149,9 @@ void setup(void)
 		init_gnss(false);
 	}
 
+	// Finish a profile that required a restart for the network mode
+	profile_resume();
+
 	// Setup callbacks and timers depending on test mode
 	switch (g_custom_parameters.test_mode)
 	{
@@ -930,27 +1200,48 @@ void setup(void)
 	oled_add_line(line_str);
 
 	// Create timer for periodic sending
-	api.system.timer.create(RAK_TIMER_0, send_packet, RAK_TIMER_PERIODIC);
-	// if (lorawan_mode)
+	api.system.timer.create(RAK_TIMER_0, send_timer_cb, RAK_TIMER_PERIODIC);
+	start_send_timer();
+
+	// Classify the motion of the device from the ACC FIFO
+	if (g_has_acc)
 	{
-		if (g_custom_parameters.send_interval != 0)
-		{
-			api.system.timer.start(RAK_TIMER_0, g_custom_parameters.send_interval, NULL);
-		}
+		mtmMain.Register(acc_fifo_task, 3000);
+	}
+
+	// Distance triggered tests in Field Tester mode
+	mtmMain.Register(gnss_distance_task, 2500);
+
+	// Battery monitor
+	mtmMain.Register(battery_task, 10000);
+
+	// Write pending results to flash
+	mtmMain.Register(log_task, 60000);
+
+	// Write settings changed in the UI to flash
+	mtmMain.Register(settings_task, 50);
+
+	// Display updates, coalesced to max 5 per second
+	if (has_oled)
+	{
+		mtmMain.Register(oled_render_task, 50);
 	}
 
+	// Timer events, the timer callbacks only set a flag for this task
+	mtmMain.Register(timer_task, 10);
+
 	//  Create timer for display handler
-	api.system.timer.create(RAK_TIMER_1, handle_display, RAK_TIMER_ONESHOT);
+	api.system.timer.create(RAK_TIMER_1, display_timer_cb, RAK_TIMER_ONESHOT);
 
 	// Create timer for display saver
-	api.system.timer.create(RAK_TIMER_2, oled_saver, RAK_TIMER_ONESHOT);
+	api.system.timer.create(RAK_TIMER_2, saver_timer_cb, RAK_TIMER_ONESHOT);
 	if (g_custom_parameters.display_saver)
 	{
 		api.system.timer.start(RAK_TIMER_2, 60000, NULL);
 	}
 
 	// Create timer for GNSS location acquisition
-	api.system.timer.create(RAK_TIMER_3, gnss_handler, RAK_TIMER_PERIODIC);
+	api.system.timer.create(RAK_TIMER_3, gnss_timer_cb, RAK_TIMER_PERIODIC);
 
 	// If LoRaWAN, start join if required
 	if (lorawan_mode)
@@ -966,16 +1257,14 @@ void setup(void)
 }
 
 /**
- * @brief Loop (unused)
+ * @brief Loop, runs the task manager
  *
  */
 void loop(void)
 {
 	// api.system.sleep.all(100);
-	if (pressCount != 0)
-	{
-		mtmMain.Running(millis());
-	}
+	// Background tasks
+	mtmMain.Running(millis());
 }
 
 /**
@@ -1003,11 +1292,102 @@ void set_linkcheck(void)
 	api.lorawan.cfm.set(false);
 	// Enable LinkCheck
 	api.lorawan.linkcheck.set(2);
-	api.lorawan.join(1, 1, 10, 50);
+	// Keep an existing session
+	if (!api.lorawan.njs.get())
+	{
+		api.lorawan.join(1, 1, 10, 50);
+	}
 	// Disable GNSS module
 	digitalWrite(WB_IO2, LOW);
 }
 
+/**
+ * @brief Switch the test mode without reboot
+ *     Stops the timers and sensors of the current mode and sets up the new mode.
+ *     Between LinkCheck and Field Tester the LoRaWAN session is kept.
+ *     Switching between LoRaWAN and LoRa P2P changes the network mode,
+ *     this requires a reboot of the RUI3 stack.
+ *     While an uplink waits for its callback the mode is not changed.
+ *
+ * @param new_mode new test mode
+ * @return uint8_t SWITCH_DONE if the mode was switched
+ *                 SWITCH_REBOOT if the device must reboot for the new mode
+ *                 SWITCH_BUSY if an uplink is in progress
+ */
+uint8_t switch_test_mode(uint8_t new_mode)
+{
+	uint8_t old_mode = g_custom_parameters.test_mode;
+	if ((old_mode == MODE_P2P) != (new_mode == MODE_P2P))
+	{
+		g_custom_parameters.test_mode = new_mode;
+		return SWITCH_REBOOT;
+	}
+	if (old_mode == new_mode)
+	{
+		return SWITCH_DONE;
+	}
+	if (tx_active)
+	{
+		MYLOG("APP", "Uplink in progress, mode not switched");
+		return SWITCH_BUSY;
+	}
+
+	// Tear down the current mode
+	api.system.timer.stop(RAK_TIMER_0);
+	api.system.timer.stop(RAK_TIMER_3);
+	gnss_active = false;
+	if (old_mode == MODE_FIELDTESTER)
+	{
+		g_has_acc = false;
+		init_acc(false);
+	}
+
+	// Set up the new mode, the GNSS sleeps unless the new mode needs the location
+	g_custom_parameters.test_mode = new_mode;
+	gnss_power_off();
+	switch (new_mode)
+	{
+	case MODE_LINKCHECK:
+		set_linkcheck();
+		break;
+	case MODE_FIELDTESTER:
+		g_has_acc = init_acc(true);
+		if (g_has_acc)
+		{
+			mtmMain.Register(acc_fifo_task, 3000);
+		}
+		// set_field_tester() powers the GNSS if location is on
+		set_field_tester();
+		break;
+	}
+	MYLOG("APP", "Switched test mode %d to %d", old_mode, new_mode);
+	status_invalidate();
+	start_send_timer();
+	return SWITCH_DONE;
+}
+
+/**
+ * @brief Restart the device in the saved test mode
+ *     The network mode of the test mode is set before the reboot
+ *
+ */
+void restart_test_mode(void)
+{
+	switch (g_custom_parameters.test_mode)
+	{
+	case MODE_LINKCHECK:
+		set_linkcheck();
+		break;
+	case MODE_P2P:
+		set_p2p();
+		break;
+	case MODE_FIELDTESTER:
+		set_field_tester();
+		break;
+	}
+	api.system.reboot();
+}
+
 /**
  * @brief Set the module for LoRa P2P testing
  *
@@ -1056,7 +1436,11 @@ void set_field_tester(void)
 	api.lorawan.cfm.set(false);
 	// Disable LinkCheck
 	api.lorawan.linkcheck.set(0);
-	api.lorawan.join(1, 1, 10, 50);
+	// Keep an existing session
+	if (!api.lorawan.njs.get())
+	{
+		api.lorawan.join(1, 1, 10, 50);
+	}
 	if (g_custom_parameters.location_on)
 	{
 		// Enable GNSS module
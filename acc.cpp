@@ -16,6 +16,38 @@ void acc_int_callback(void);
 /** The LIS3DH sensor */
 LIS3DH acc_sensor(I2C_MODE, 0x18);
 
+/** Flag if the ACC sensor was found and motion detection is active */
+bool g_has_acc = false;
+
+/** Flag if the device was moved since motion detection was armed */
+volatile bool g_acc_moved = true;
+
+/** Number of samples in the LIS3DH FIFO */
+#define ACC_FIFO_SIZE 32
+/** Bytes per FIFO sample (X, Y, Z, 16 bit each) */
+#define ACC_SAMPLE_SIZE 6
+/** Max number of samples per I2C read (Wire buffer is 32 bytes) */
+#define ACC_SAMPLES_PER_READ 5
+/** Mean absolute deviation below which the device is still (mg) */
+#define ACC_STILL_MAD_MG 24
+/** Mean absolute deviation above which the device is carried by a walking person (mg) */
+#define ACC_WALK_MAD_MG 100
+/** Max zero crossings in a FIFO window for a walking pattern (steps are ~2 Hz) */
+#define ACC_WALK_MAX_CROSSINGS 20
+/** Hysteresis for zero crossing detection (mg) */
+#define ACC_CROSSING_HYST_MG 16
+/** Send interval factor when the device is still */
+#define ACC_STILL_INTERVAL_FACTOR 4
+/** Shortest send interval when driving (ms) */
+#define ACC_MIN_SEND_INTERVAL 15000
+
+/** Classified motion of the device */
+volatile uint8_t g_motion_class = MOTION_UNKNOWN;
+/** Last classification result, a new class needs two matching windows */
+uint8_t last_motion_class = MOTION_UNKNOWN;
+/** Buffer for the FIFO burst read */
+uint8_t fifo_buffer[ACC_FIFO_SIZE * ACC_SAMPLE_SIZE];
+
 /**
  * @brief Initialize LIS3DH 3-axis
  *
@@ -119,6 +151,9 @@ bool init_acc(bool active)
 		attachInterrupt(ACC_INT_PIN, acc_int_callback, RISING);
 
 		read_acc();
+
+		// Collect samples for the motion classification
+		acc_fifo_start();
 	}
 	else
 	{
@@ -131,27 +166,264 @@ bool init_acc(bool active)
 }
 
 /**
- * @brief Read sensor values (unused)
- * 
+ * @brief Convert a raw left-justified sample to mg
+ *     Low power mode, +/-2g range: 8 bit data, 16 mg per digit
+ *
+ * @param raw pointer to the low byte of the sample
+ * @return int16_t acceleration in mg
+ */
+static inline int16_t acc_raw_to_mg(uint8_t *raw)
+{
+	return (int16_t)((int8_t)raw[1]) * 16;
+}
+
+/**
+ * @brief Read sensor values with a single burst read (debug output only)
+ *
  */
 void read_acc(void)
 {
-	int16_t acc_x = (int16_t)(acc_sensor.readFloatAccelX() * 1000.0);
-	int16_t acc_y = (int16_t)(acc_sensor.readFloatAccelY() * 1000.0);
-	int16_t acc_z = (int16_t)(acc_sensor.readFloatAccelZ() * 1000.0);
+	uint8_t raw[ACC_SAMPLE_SIZE];
+	if (acc_sensor.readRegisterRegion(raw, LIS3DH_OUT_X_L, ACC_SAMPLE_SIZE) != 0)
+	{
+		MYLOG("ACC", "Read failed");
+		return;
+	}
+
+	MYLOG("ACC", "X %d Y %d Z %d mg", acc_raw_to_mg(&raw[0]), acc_raw_to_mg(&raw[2]), acc_raw_to_mg(&raw[4]));
+}
+
+/**
+ * @brief Integer square root
+ *
+ * @param value input value
+ * @return uint32_t floor(sqrt(value))
+ */
+uint32_t int_sqrt(uint64_t value)
+{
+	uint64_t result = 0;
+	uint64_t bit = (uint64_t)1 << 62;
+
+	while (bit > value)
+	{
+		bit >>= 2;
+	}
+	while (bit != 0)
+	{
+		if (value >= result + bit)
+		{
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else
+		{
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (uint32_t)result;
+}
+
+/**
+ * @brief Enable the LIS3DH FIFO in stream mode
+ *     The FIFO collects 32 samples (3.2 seconds at 10 Hz)
+ *
+ */
+void acc_fifo_start(void)
+{
+	uint8_t data_to_write = 0;
+	acc_sensor.readRegister(&data_to_write, LIS3DH_CTRL_REG5);
+	data_to_write |= 0x40; // FIFO enable
+	acc_sensor.writeRegister(LIS3DH_CTRL_REG5, data_to_write);
 
-	MYLOG("ACC", "X %.3f %.3f %d", acc_sensor.readFloatAccelX(), acc_sensor.readFloatAccelX() * 1000.0, acc_x);
-	MYLOG("ACC", "Y %.3f %.3f %d", acc_sensor.readFloatAccelY(), acc_sensor.readFloatAccelY() * 1000.0, acc_y);
-	MYLOG("ACC", "Z %.3f %.3f %d", acc_sensor.readFloatAccelZ(), acc_sensor.readFloatAccelZ() * 1000.0, acc_z);
+	// Stream mode, oldest samples are overwritten
+	acc_sensor.writeRegister(LIS3DH_FIFO_CTRL_REG, 0x80);
 }
 
 /**
- * @brief ACC interrupt handler (unused)
+ * @brief Classify the motion from a window of samples
+ *     Uses only integer math on the acceleration magnitude
+ *
+ * @param samples X, Y, Z values in mg
+ * @param count number of samples
+ * @return uint8_t motion class (MOTION_STILL, MOTION_WALKING or MOTION_DRIVING)
+ */
+uint8_t acc_classify(int16_t samples[][3], uint8_t count)
+{
+	if (count < 4)
+	{
+		return MOTION_UNKNOWN;
+	}
+
+	uint16_t magnitude[ACC_FIFO_SIZE];
+	uint32_t sum = 0;
+	for (uint8_t idx = 0; idx < count; idx++)
+	{
+		int32_t x = samples[idx][0];
+		int32_t y = samples[idx][1];
+		int32_t z = samples[idx][2];
+		magnitude[idx] = int_sqrt((uint64_t)(x * x + y * y + z * z));
+		sum += magnitude[idx];
+	}
+	int32_t mean = sum / count;
+
+	// Mean absolute deviation and zero crossings around the mean
+	uint32_t deviation = 0;
+	uint8_t crossings = 0;
+	int8_t last_sign = 0;
+	for (uint8_t idx = 0; idx < count; idx++)
+	{
+		int32_t diff = (int32_t)magnitude[idx] - mean;
+		deviation += diff < 0 ? -diff : diff;
+		if (diff > ACC_CROSSING_HYST_MG)
+		{
+			if (last_sign < 0)
+			{
+				crossings++;
+			}
+			last_sign = 1;
+		}
+		else if (diff < -ACC_CROSSING_HYST_MG)
+		{
+			if (last_sign > 0)
+			{
+				crossings++;
+			}
+			last_sign = -1;
+		}
+	}
+	uint32_t mad = deviation / count;
+
+	if (mad < ACC_STILL_MAD_MG)
+	{
+		return MOTION_STILL;
+	}
+	if ((mad >= ACC_WALK_MAD_MG) && (crossings <= ACC_WALK_MAX_CROSSINGS))
+	{
+		return MOTION_WALKING;
+	}
+	return MOTION_DRIVING;
+}
+
+/**
+ * @brief Drain the LIS3DH FIFO and classify the motion
+ *     Called every 3 seconds by the task manager
+ *     Restarts the send timer if the motion class changed
+ *
+ */
+void acc_fifo_task(void)
+{
+	if (!g_has_acc)
+	{
+		return;
+	}
+
+	uint8_t fifo_src = 0;
+	acc_sensor.readRegister(&fifo_src, LIS3DH_FIFO_SRC_REG);
+	uint8_t count = (fifo_src & 0x40) ? ACC_FIFO_SIZE : (fifo_src & 0x1F);
+	if (count == 0)
+	{
+		return;
+	}
+
+	// Burst reads of max 5 samples, the register address auto-increments and wraps in FIFO mode
+	for (uint8_t idx = 0; idx < count; idx += ACC_SAMPLES_PER_READ)
+	{
+		uint8_t chunk = (count - idx) < ACC_SAMPLES_PER_READ ? (count - idx) : ACC_SAMPLES_PER_READ;
+		if (acc_sensor.readRegisterRegion(&fifo_buffer[idx * ACC_SAMPLE_SIZE], LIS3DH_OUT_X_L, chunk * ACC_SAMPLE_SIZE) != 0)
+		{
+			MYLOG("ACC", "FIFO read failed");
+			return;
+		}
+	}
+
+	int16_t samples[ACC_FIFO_SIZE][3];
+	for (uint8_t idx = 0; idx < count; idx++)
+	{
+		samples[idx][0] = acc_raw_to_mg(&fifo_buffer[idx * ACC_SAMPLE_SIZE]);
+		samples[idx][1] = acc_raw_to_mg(&fifo_buffer[idx * ACC_SAMPLE_SIZE + 2]);
+		samples[idx][2] = acc_raw_to_mg(&fifo_buffer[idx * ACC_SAMPLE_SIZE + 4]);
+	}
+
+	uint8_t motion = acc_classify(samples, count);
+
+	// Require two matching windows before changing the cadence
+	if ((motion == last_motion_class) && (motion != g_motion_class))
+	{
+		g_motion_class = motion;
+		MYLOG("ACC", "Motion class %d", g_motion_class);
+		if ((g_custom_parameters.test_mode == MODE_FIELDTESTER) && !g_settings_ui)
+		{
+			start_send_timer();
+		}
+	}
+	last_motion_class = motion;
+}
+
+/**
+ * @brief Adjust the send interval to the motion of the device
+ *     Still: less tests, driving: more tests
+ *
+ * @param interval configured send interval in ms
+ * @return uint32_t send interval to use in ms
+ */
+uint32_t acc_adjust_interval(uint32_t interval)
+{
+	if ((interval == 0) || (g_custom_parameters.test_mode != MODE_FIELDTESTER))
+	{
+		return interval;
+	}
+
+	switch (g_motion_class)
+	{
+	case MOTION_STILL:
+		return interval * ACC_STILL_INTERVAL_FACTOR;
+	case MOTION_DRIVING:
+		interval = interval / 2;
+		return interval < ACC_MIN_SEND_INTERVAL ? ACC_MIN_SEND_INTERVAL : interval;
+	default:
+		return interval;
+	}
+}
+
+/**
+ * @brief ACC interrupt handler
+ *     Only sets the motion flag, the latched interrupt
+ *     is cleared outside of the interrupt context
  *
  */
 void acc_int_callback(void)
 {
+	g_acc_moved = true;
+}
+
+/**
+ * @brief Check if the device was moved since the last acc_rearm()
+ *
+ * @return true device was moved or no ACC sensor available
+ * @return false device is stationary
+ */
+bool acc_check_moved(void)
+{
+	if (!g_has_acc)
+	{
+		return true;
+	}
+	return g_acc_moved;
+}
 
+/**
+ * @brief Clear the motion flag and the latched ACC interrupt
+ *
+ */
+void acc_rearm(void)
+{
+	if (!g_has_acc)
+	{
+		return;
+	}
+	g_acc_moved = false;
+	clear_acc_int();
 }
 
 /**
@@ -56,6 +56,9 @@
 // #define SW_VERSION_1 0
 // #define SW_VERSION_2 1
 
+/** Max number of payload generator fields */
+#define PCKG_FIELDS_MAX 8
+
 /** Custom flash parameters structure */
 struct custom_param_s
 {
@@ -66,6 +69,15 @@ struct custom_param_s
 	bool location_on = false;
 	uint8_t custom_packet[129] = {0x01, 0x02, 0x03, 0x04};
 	uint16_t custom_packet_len = 4;
+	uint16_t send_distance = 0;
+	uint8_t skip_covered = 0;
+	bool telemetry = false;
+	uint16_t instant_tx = 0;
+	uint8_t profile_pending = 0xFF;
+	char pckg_fields[PCKG_FIELDS_MAX + 1] = "";
+	uint8_t pckg_min = 0;
+	uint8_t pckg_max = 0;
+	uint8_t pckg_step = 0;
 };
 
 typedef enum test_mode_num
@@ -83,12 +95,38 @@ bool init_status_at(void);
 bool init_interval_at(void);
 bool init_test_mode_at(void);
 bool init_custom_pckg_at(void);
+bool init_send_distance_at(void);
+bool init_skip_covered_at(void);
+bool init_telemetry_at(void);
+bool init_instant_tx_at(void);
+bool init_profile_at(void);
+bool init_stats_at(void);
 bool get_at_setting(void);
 bool save_at_setting(void);
 void set_linkcheck(void);
 void set_p2p(void);
 void set_field_tester(void);
+/** Result of a test mode switch */
+enum switch_result_e
+{
+	SWITCH_DONE = 0, // New mode is active
+	SWITCH_REBOOT,	 // Network mode changes, the device must reboot
+	SWITCH_BUSY		 // Uplink in progress, mode not changed
+};
+uint8_t switch_test_mode(uint8_t new_mode);
+void restart_test_mode(void);
 void send_packet(void *data);
+void start_send_timer(void);
+void timer_task(void);
+void handle_display(void *reason);
+/** Timer events, set by the timer callbacks and handled in the loop by timer_task() */
+#define EVENT_SEND 0x01
+#define EVENT_DISPLAY 0x02
+#define EVENT_SAVER 0x04
+#define EVENT_GNSS 0x08
+#define EVENT_BUTTON 0x10
+extern volatile uint8_t timer_events;
+bool prepare_tx(void);
 uint8_t get_min_dr(uint16_t region, uint16_t payload_size);
 void get_min_max_dr(uint16_t region, uint8_t *min_dr, uint8_t *max_dr);
 extern uint32_t g_send_repeat_time;
@@ -96,6 +134,14 @@ extern bool lorawan_mode;
 extern bool use_link_check;
 extern volatile bool tx_active;
 extern volatile bool forced_tx;
+extern volatile int8_t last_snr;
+extern volatile int16_t last_rssi;
+extern volatile uint8_t link_check_demod_margin;
+extern volatile uint8_t link_check_gateways;
+extern volatile int32_t packet_num;
+extern volatile int32_t packet_lost;
+extern volatile uint8_t last_dr;
+extern volatile int32_t tx_fail_status;
 
 // LoRaWAN stuff
 #include "wisblock_cayenne.h"
@@ -109,13 +155,22 @@ void oled_write_header(char *header_line);
 void oled_clear(void);
 void oled_write_line(int16_t line, int16_t y_pos, String text);
 void oled_display(void);
+void oled_flush(void);
+void oled_render_task(void);
+void graph_add(int16_t rssi, int8_t snr);
+void graph_toggle(void);
+void oled_get_stats(uint32_t *flushes, uint32_t *bytes, uint32_t *last_bytes, uint32_t *last_time);
+void oled_reset_stats(void);
+void oled_get_row(uint8_t row, char *line);
+bool init_oled_at(void);
+extern bool g_graph_view;
 void oled_power(bool on_off);
-void display_show_menu(char *menu[], uint8_t menu_len, uint8_t sel_menu, uint8_t sel_item, bool display_saver = false, bool location_on = false);
+void oled_clear_line(int16_t line, int16_t x_pos, int16_t lines);
 void oled_saver(void *);
 extern custom_param_s g_last_settings;
 extern char line_str[];
 extern char *g_regions_list[];
-extern char *p_bw_menu[];
+extern const char *const p_bw_menu[];
 extern bool has_oled;
 
 // UI
@@ -138,9 +193,23 @@ typedef enum disp_mode_num
 	S_P2P_CR,
 	S_P2P_PPL,
 	S_P2P_TX,
+	T_PROF_MENU,
 	S_SUB_NONE = 255
 };
 extern bool g_settings_ui;
+extern uint8_t sel_menu;
+extern uint8_t ui_last_dr;
+extern uint8_t ui_last_band;
+extern uint8_t ui_last_adr;
+extern uint8_t ui_last_tx;
+extern uint32_t ui_p2p_freq;
+extern uint8_t ui_p2p_sf;
+extern uint8_t ui_p2p_bw;
+extern uint8_t ui_p2p_cr;
+extern uint8_t ui_p2p_tx;
+void menu_show(uint8_t menu);
+void menu_click(uint8_t clicks);
+void save_n_reboot(void);
 
 // Button
 #include "MillisTaskManager.h"
@@ -159,15 +228,19 @@ typedef enum
 	QUAD_CLICK,
 	FIVE_CLICK,
 	SIX_CLICK,
+	INSTANT_TX,
 	BUTTONSTATE_NONE,
 } buttonState_t;
 
+/** Longest hold time for the instant TX gesture in ms, must be shorter than a long press */
+#define INSTANT_TX_MAX 2500
+
 bool buttonInit(void);
 uint8_t getButtonStatus(void);
 void handle_button(void);
 void buttonIntHandle(void);
+void button_deadline(void *);
 extern MillisTaskManager mtmMain;
-extern volatile uint8_t pressCount;
 extern volatile bool display_power;
 
 // ACC
@@ -176,21 +249,182 @@ extern volatile bool display_power;
 bool init_acc(bool active = false);
 void clear_acc_int(void);
 void read_acc(void);
+bool acc_check_moved(void);
+void acc_rearm(void);
+void acc_fifo_start(void);
+void acc_fifo_task(void);
+uint32_t acc_adjust_interval(uint32_t interval);
+uint8_t acc_classify(int16_t samples[][3], uint8_t count);
+uint32_t int_sqrt(uint64_t value);
+extern bool g_has_acc;
+
+/** Motion classes from the ACC FIFO data */
+typedef enum
+{
+	MOTION_UNKNOWN = 0,
+	MOTION_STILL,
+	MOTION_WALKING,
+	MOTION_DRIVING
+} motion_class_t;
+extern volatile uint8_t g_motion_class;
 
 // GNSS
 #include <SparkFun_u-blox_GNSS_Arduino_Library.h>
 bool init_gnss(bool active = false);
+void gnss_power_off(void);
+void gnss_park(void);
+void gnss_wake(void);
 bool poll_gnss(void);
 void gnss_handler(void *);
+void gnss_acq_start(void);
+bool gnss_acq_satisfied(uint8_t fix_type, uint8_t sats);
+bool gnss_acq_extend(void);
+void gnss_acq_record(bool success);
+bool gnss_reuse_fix(void);
+void gnss_distance_task(void);
+int32_t gnss_cos_q15(int32_t lat);
+uint32_t gnss_distance_m(int32_t lat1, int32_t long1, int32_t lat2, int32_t long2);
+uint8_t fmt_fixed(char *buf, int32_t value, uint8_t scale, uint8_t decimals);
+uint8_t fmt_location(char *buf, const char *prefix, const char *separator, int32_t lat, int32_t lon, uint8_t decimals);
 extern bool gnss_active;
 extern uint16_t check_gnss_counter;
 extern uint16_t check_gnss_max_try;
 extern uint8_t max_sat;
 extern uint8_t max_sat_unchanged;
-extern volatile float g_last_lat;
-extern volatile float g_last_long;
-extern volatile float g_last_accuracy;
+extern volatile int32_t g_last_lat;
+extern volatile int32_t g_last_long;
+extern volatile uint16_t g_last_accuracy;
 extern volatile uint32_t g_last_altitude;
 extern volatile uint8_t g_last_satellites;
 
+// Coverage grid
+/** Number of cells in the coverage grid (power of 2) */
+#define GRID_SIZE 128
+/** Statistics of a coverage grid cell */
+struct grid_cell_s
+{
+	int32_t lat_idx;  // Row of the cell
+	int32_t long_idx; // Column of the cell
+	uint16_t count;	  // Number of samples, 0 = empty cell
+	int16_t rssi_min; // Lowest best-gateway RSSI
+	int16_t rssi_max; // Highest best-gateway RSSI
+	int32_t rssi_sum; // Sum of RSSI values for the mean
+	uint8_t gw_min;	  // Lowest number of gateways
+	uint8_t gw_max;	  // Highest number of gateways
+	uint32_t gw_sum;  // Sum of gateways for the mean
+};
+void coverage_add(int32_t lat, int32_t lon, int16_t rssi, uint8_t gateways);
+void coverage_cell(int32_t lat, int32_t lon, int32_t *lat_idx, int32_t *long_idx);
+void coverage_cell_center(grid_cell_s *cell, int32_t *lat, int32_t *lon);
+grid_cell_s *coverage_slot(uint16_t slot);
+void coverage_clear(void);
+bool coverage_skip(int32_t lat, int32_t lon);
+bool init_grid_at(void);
+extern uint16_t g_grid_used;
+extern uint16_t g_grid_dropped;
+
+// Flash layout
+#if defined(_VARIANT_RAK3172_) || defined(_VARIANT_RAK3172_SIP_)
+#define APP_FLASH_PAGE_SIZE 2048
+#else // RAK4630 || RAK11720
+#define APP_FLASH_PAGE_SIZE 4096
+#endif
+/** Start of the custom settings record store, uses 2 flash pages */
+#define SETTINGS_FLASH_START 0
+/** Start of the test profiles, uses 1 flash page */
+#define PROFILE_FLASH_START (2 * APP_FLASH_PAGE_SIZE)
+/** Start of the result log in the user flash */
+#define LOG_FLASH_START (4 * APP_FLASH_PAGE_SIZE)
+/** Number of flash pages used for the result log, init_log() checks that the user flash covers them */
+#define LOG_FLASH_PAGES 4
+
+// Result log
+/** Result log record, 24 bytes without padding */
+struct log_record_s
+{
+	uint32_t seq;	  // Sequence number, 0xFFFFFFFF = empty
+	uint32_t time;	  // Uptime in seconds
+	int32_t lat;	  // Latitude in 1e-7 degrees
+	int32_t lon;	  // Longitude in 1e-7 degrees
+	int16_t rssi;	  // RSSI
+	int8_t snr;		  // SNR
+	int8_t margin;	  // Demodulation margin
+	uint8_t mode;	  // Test mode
+	uint8_t gateways; // Number of gateways
+	uint16_t crc;	  // CRC16 over the record without the CRC
+};
+uint16_t crc16(const uint8_t *data, uint16_t len);
+void init_log(void);
+void log_result(uint8_t event, int16_t rssi, int8_t snr, int8_t margin, uint8_t gateways);
+void log_flush(void);
+void log_task(void);
+bool log_read(uint16_t index, log_record_s *record);
+void log_erase(void);
+bool init_log_at(void);
+extern uint16_t g_log_count;
+
+// Settings store
+bool settings_load(custom_param_s *params);
+bool settings_save(const custom_param_s *params);
+void settings_commit(void (*done)(bool result));
+void settings_task(void);
+
+// Test profiles
+/** Number of profile slots */
+#define PROFILE_MAX 4
+/** Max length of a profile name including the terminating 0 */
+#define PROFILE_NAME_LEN 16
+/** No profile waiting for the restart */
+#define PROFILE_NONE 0xFF
+/** Test profile, stored in flash */
+struct profile_s
+{
+	char name[PROFILE_NAME_LEN];			// Profile name
+	uint32_t send_interval;					// Send interval in ms
+	uint8_t test_mode;						// Test mode
+	bool location_on;						// Location in Field Tester mode
+	uint16_t custom_packet_len;				// Length of the custom packet
+	uint8_t custom_packet[128];				// Custom packet
+	uint32_t p2p_freq;						// LoRa P2P frequency in Hz
+	uint8_t p2p_sf;							// LoRa P2P spreading factor
+	uint8_t p2p_bw;							// LoRa P2P bandwidth index
+	uint8_t p2p_cr;							// LoRa P2P coding rate index
+	uint8_t p2p_tx;							// LoRa P2P TX power
+	uint8_t lpw_band;						// LoRaWAN region
+	uint8_t lpw_dr;							// LoRaWAN datarate
+	uint8_t lpw_tx;							// LoRaWAN TX power index
+	uint8_t lpw_adr;						// LoRaWAN ADR
+	char pckg_fields[PCKG_FIELDS_MAX + 1];	// Payload generator fields, empty = custom packet
+	uint8_t pckg_min;						// Payload generator shortest packet
+	uint8_t pckg_max;						// Payload generator longest packet
+	uint8_t pckg_step;						// Payload generator size step
+	uint16_t crc;							// CRC16 over the profile without the CRC
+};
+bool profile_get(uint8_t slot, profile_s *profile);
+bool profile_store(uint8_t slot, const char *name);
+bool profile_delete(uint8_t slot);
+bool profile_apply(uint8_t slot, bool *restart);
+void profile_resume(void);
+
+// Payload generator
+bool payload_check(const char *fields, uint8_t min_len, uint8_t max_len, uint8_t step);
+uint16_t payload_max_len(void);
+void payload_reset(void);
+uint8_t *payload_next(uint16_t *len);
+
+// Status line
+/** Size of the buffer for the status line */
+#define STATUS_LINE_SIZE 384
+void status_invalidate(void);
+uint16_t status_line(char *buf);
+
+// Battery
+void init_battery(void);
+void battery_task(void);
+extern volatile uint16_t g_battery_mv;
+extern volatile uint8_t g_battery_soc;
+
+// Telemetry
+void telemetry_send(uint8_t event, log_record_s *record);
+
 #endif // _APP_H_
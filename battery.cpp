@@ -0,0 +1,93 @@
+/**
+ * @file battery.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Background battery monitor with cached values
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Number of entries in the discharge curve */
+#define BAT_CURVE_LEN 11
+
+/** LiPo discharge curve, battery voltage in mV and state of charge in % */
+const uint16_t bat_curve[BAT_CURVE_LEN][2] = {
+	{4200, 100},
+	{4100, 90},
+	{4000, 80},
+	{3950, 70},
+	{3900, 60},
+	{3850, 50},
+	{3800, 40},
+	{3750, 30},
+	{3700, 20},
+	{3600, 10},
+	{3400, 0}};
+
+/** Filtered battery voltage in mV */
+volatile uint16_t g_battery_mv = 0;
+/** Estimated state of charge in % */
+volatile uint8_t g_battery_soc = 0;
+
+/**
+ * @brief Get the state of charge from the discharge curve
+ *
+ * @param mv battery voltage in mV
+ * @return uint8_t state of charge in %
+ */
+static uint8_t battery_soc(uint16_t mv)
+{
+	if (mv >= bat_curve[0][0])
+	{
+		return 100;
+	}
+	for (uint8_t idx = 1; idx < BAT_CURVE_LEN; idx++)
+	{
+		if (mv >= bat_curve[idx][0])
+		{
+			// Linear interpolation between the curve points
+			uint16_t mv_range = bat_curve[idx - 1][0] - bat_curve[idx][0];
+			uint16_t soc_range = bat_curve[idx - 1][1] - bat_curve[idx][1];
+			return bat_curve[idx][1] + ((mv - bat_curve[idx][0]) * soc_range) / mv_range;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief Battery monitor task, called every 10 seconds
+ *     Keeps an EWMA (1/8) of the battery voltage and the state of charge
+ *
+ */
+void battery_task(void)
+{
+	uint16_t sample = (uint16_t)(api.system.bat.get() * 1000);
+	if (g_battery_mv == 0)
+	{
+		g_battery_mv = sample;
+	}
+	else
+	{
+		g_battery_mv = (int32_t)g_battery_mv + ((int32_t)sample - (int32_t)g_battery_mv) / 8;
+	}
+	g_battery_soc = battery_soc(g_battery_mv);
+}
+
+/**
+ * @brief Initialize the battery monitor with an average of 10 samples
+ *
+ */
+void init_battery(void)
+{
+	uint32_t sum = 0;
+	for (int idx = 0; idx < 10; idx++)
+	{
+		sum += (uint32_t)(api.system.bat.get() * 1000);
+	}
+	g_battery_mv = sum / 10;
+	g_battery_soc = battery_soc(g_battery_mv);
+	MYLOG("BAT", "Battery %d mV %d%%", g_battery_mv, g_battery_soc);
+}
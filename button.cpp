@@ -11,39 +11,71 @@
 #include "app.h"
 #include "udrv_dfu.h"
 
-/** Button press time value */
-volatile static time_t pressTime = 0;
-
-/** Number of clicks counter */
-volatile uint8_t pressCount = 0;
-
-/** Timestamp for first button press event */
-static time_t firstPressTime = 0;
+/** Time the button level must be stable in ms */
+#define BTN_DEBOUNCE 25
+/** Max time between release and next press of a multi click in ms */
+#define BTN_CLICK_GAP 250
+/** Time the button must be held for a long press in ms */
+#define BTN_LONG_PRESS 3000
+/** Number of edges in the ring buffer (power of 2) */
+#define BTN_RING_SIZE 16
+
+/** Button edge captured by the interrupt handler */
+struct btn_edge_s
+{
+	uint32_t time; // Timestamp in ms
+	uint8_t level; // Pin level after the edge
+};
+/** Ring buffer of button edges, written only by the interrupt handler */
+volatile btn_edge_s btn_ring[BTN_RING_SIZE];
+/** Ring buffer write index, changed only by the interrupt handler */
+volatile uint8_t btn_head = 0;
+/** Ring buffer read index, changed only by the gesture decoder */
+volatile uint8_t btn_tail = 0;
+
+/** Gesture decoder states */
+enum btn_state_e
+{
+	BTN_IDLE = 0, // Button released, no gesture in progress
+	BTN_PRESSED,  // Button pressed
+	BTN_RELEASED, // Button released, waiting for the next click
+	BTN_HELD	  // Long press reported, waiting for the release
+};
+/** Gesture decoder state */
+uint8_t btn_state = BTN_IDLE;
+/** Time of the last edge in the ring buffer */
+uint32_t btn_last_edge = 0;
+/** Time of the first edge after the button level was stable */
+uint32_t btn_burst_start = 0;
+/** Flag if edges are waiting for the debounce time */
+bool btn_bouncing = false;
+/** Pin level after the last edge */
+uint8_t btn_level = HIGH;
+/** Time of the last press or release */
+uint32_t btn_change_time = 0;
+/** Number of clicks of the current gesture */
+uint8_t btn_clicks = 0;
+/** Time of the first press of the current gesture */
+uint32_t btn_gesture_time = 0;
+/** Flag if the instant TX gesture was reported for the current press */
+bool btn_instant_sent = false;
+/** Decoded gesture, BUTTONSTATE_NONE if nothing to handle */
+volatile uint8_t btn_gesture = BUTTONSTATE_NONE;
 
 /** Flag if UI is active or not */
 bool g_settings_ui = false;
-/** Current selected menu */
-uint8_t sel_menu = 0;
 /** Flag if changes require a restart */
 bool restart_required = false;
 /** Buffer for original settings */
 custom_param_s g_last_settings;
 /** Buffer of DR changes */
 uint8_t ui_last_dr = 0;
-/** Highest possible DR, depends on LoRaWAN region */
-uint8_t ui_max_dr = 0;
-/** Lowest possible DR, depends on LoRaWAN region */
-uint8_t ui_min_dr = 0;
 /** Selected LoRaWAN region */
 uint8_t ui_last_band = 0;
 /** Selected ADR status */
 uint8_t ui_last_adr = 0;
 /** Buffer for TX power changes */
 uint8_t ui_last_tx = 0;
-/** Highest possible TX, depends on LoRaWAN region */
-uint8_t ui_max_tx = 0;
-/** Lowest possible TX, depends on LoRaWAN region */
-uint8_t ui_min_tx = 0;
 /** Buffer for P2P frequency selection */
 uint32_t ui_p2p_freq = 0;
 /** Buffer for P2P SF selection */
@@ -55,38 +87,8 @@ uint8_t ui_p2p_cr = 0;
 /** Buffer for P2P TX power selection */
 uint8_t ui_p2p_tx = 0;
 
-/** Content of top level menu */
-char *top_menu[] = {"Back", "Info", "Device Settings", "Mode", "LoRa Setting"};
-/** Size of top level menu */
-uint8_t top_menu_len = 5;
-
-/** Content for menus with only "Back" */
-char *back_menu[] = {"Back"};
-/** Size fo "Back" only menus */
-uint8_t back_menu_len = 1;
-
-/** Content of device settings menu */
-char *settings_menu[] = {"Back", "Interval", "Location", "Display Saver"};
-/** Size of device settings menu */
-uint8_t settings_menu_len = 4;
-
-/** Content of test mode menu */
-char *mode_menu[] = {"Back", "LPW LinkCheck", "P2P", "Field Tester"};
-/** Size of test mode menu */
-uint8_t mode_menu_len = 4;
-
-/** Content of P2P settings menu */
-char *settings_p2p_menu[] = {"Back", "Freq", "SF", "BW", "CR", "TX"};
-/** Size of P2P settings menu */
-uint8_t settings_p2p_menu_len = 6;
-
-/** Content of LoRaWAN settings menu */
-char *settings_lpw_menu[] = {"Back", "ADR", "DR", "TX", "Region"};
-/** Size of LoRaWAN settings menu */
-uint8_t settings_lpw_menu_len = 5;
-
 /** Table with P2P bandwidths */
-char *p_bw_menu[] = {"500", "250", "125", "62.5", "41.67", "31.25", "20.83", "15.63", "10.4", "7.8"};
+const char *const p_bw_menu[] = {"500", "250", "125", "62.5", "41.67", "31.25", "20.83", "15.63", "10.4", "7.8"};
 
 /**
  * @brief Initialize button handler
@@ -99,142 +101,283 @@ char *p_bw_menu[] = {"500", "250", "125", "62.5", "41.67", "31.25", "20.83", "15
 bool buttonInit(void)
 {
 	pinMode(BUTTON_INT_PIN, INPUT_PULLUP);
-	attachInterrupt(BUTTON_INT_PIN, buttonIntHandle, FALLING);
 
-	mtmMain.Register(handle_button, 100); // Process button data every 100ms.
+	// Gesture deadlines
+	api.system.timer.create(RAK_TIMER_4, button_deadline, RAK_TIMER_ONESHOT);
+
+	attachInterrupt(BUTTON_INT_PIN, buttonIntHandle, CHANGE);
 
 	return true;
 }
 
 /**
  * @brief Button interrupt handler
+ *     Only stores the edge in the ring buffer and starts the
+ *     debounce deadline, the gesture is decoded in button_deadline
  *
  */
 void buttonIntHandle(void)
 {
-	pressTime = millis();
-	if ((millis() - firstPressTime) > 200) // for button debounce.
+	uint8_t next = (btn_head + 1) & (BTN_RING_SIZE - 1);
+	if (next != btn_tail)
 	{
-		firstPressTime = millis();
-		pressCount += 1;
+		btn_ring[btn_head].time = millis();
+		btn_ring[btn_head].level = digitalRead(BUTTON_INT_PIN);
+		btn_head = next;
 	}
-	MYLOG("BTN", "pressCount = %d", pressCount);
+	else
+	{
+		// Ring buffer full (heavy bouncing), keep the latest level
+		uint8_t last = (btn_head - 1) & (BTN_RING_SIZE - 1);
+		btn_ring[last].time = millis();
+		btn_ring[last].level = digitalRead(BUTTON_INT_PIN);
+	}
+	api.system.timer.start(RAK_TIMER_4, BTN_DEBOUNCE, NULL);
 }
 
 /**
- * @brief Button Status handler
+ * @brief Gesture decoder, called when a deadline of RAK_TIMER_4 is reached
+ *     Classifies single, multi clicks and long press from the edge timestamps.
+ *     Only decodes the gesture, the action runs in the loop by timer_task
+ *     - a press or release is valid after the level was stable for BTN_DEBOUNCE
+ *     - a multi click ends BTN_CLICK_GAP after the last release
+ *     - a long press is reported after BTN_LONG_PRESS, even if the button is still pressed
+ *     - if enabled, instant TX is reported when the first press is held for ATC+ITX ms
  *
- * @return uint8_t button status, number of clicks or long press detection
  */
-uint8_t getButtonStatus(void)
+void button_deadline(void *)
 {
-	uint8_t lowCount = 0;
-	if (((millis() - pressTime) > 3000) && (digitalRead(BUTTON_INT_PIN) == LOW) && (pressCount >= 1))
-	{
-		return LONG_PRESS;
-	}
+	uint32_t now = millis();
 
-	if (((millis() - pressTime) >= 400) && (pressCount == 1) && (digitalRead(BUTTON_INT_PIN) == HIGH))
+	// Read the captured edges
+	while (btn_tail != btn_head)
 	{
-		uint8_t highCount = 0;
-		for (uint8_t i; i < 200; i++)
+		if (!btn_bouncing)
 		{
-			if (digitalRead(BUTTON_INT_PIN) == HIGH)
-				highCount++;
-			delay(1);
-		}
-		if (highCount > 198) // Have no option but to.
-		{
-			return SINGLE_CLICK;
+			btn_burst_start = btn_ring[btn_tail].time;
+			btn_bouncing = true;
 		}
+		btn_last_edge = btn_ring[btn_tail].time;
+		btn_level = btn_ring[btn_tail].level;
+		btn_tail = (btn_tail + 1) & (BTN_RING_SIZE - 1);
 	}
 
-	if (((millis() - pressTime) >= 400) && (pressCount == 2) && (digitalRead(BUTTON_INT_PIN) == HIGH))
+	if (btn_bouncing)
 	{
-		uint8_t highCount = 0;
-		for (uint8_t i; i < 200; i++)
-		{
-			if (digitalRead(BUTTON_INT_PIN) == HIGH)
-				highCount++;
-			delay(1);
-		}
-		if (highCount > 198) // Have no option but to.
+		if ((now - btn_last_edge) < BTN_DEBOUNCE)
 		{
-			return DOUBLE_CLICK;
+			// Level not yet stable
+			api.system.timer.start(RAK_TIMER_4, BTN_DEBOUNCE - (now - btn_last_edge), NULL);
+			return;
 		}
-	}
+		btn_bouncing = false;
 
-	if (((millis() - pressTime) >= 600) && (pressCount == 3))
-	{
-		uint8_t highCount = 0;
-		for (uint8_t i; i < 200; i++)
+		if ((btn_level == LOW) && ((btn_state == BTN_IDLE) || (btn_state == BTN_RELEASED)))
 		{
-			if (digitalRead(BUTTON_INT_PIN) == HIGH)
-				highCount++;
-			delay(1);
+			if (btn_state == BTN_IDLE)
+			{
+				btn_gesture_time = btn_burst_start;
+			}
+			btn_state = BTN_PRESSED;
+			btn_change_time = btn_burst_start;
 		}
-		if (highCount > 198) // Have no option but to.
+		else if ((btn_level == HIGH) && (btn_state == BTN_PRESSED) && btn_instant_sent)
 		{
-			return TRIPPLE_CLICK;
+			// Release after an instant TX, not counted as click
+			btn_state = BTN_IDLE;
+			btn_instant_sent = false;
 		}
-	}
-
-	if (((millis() - pressTime) >= 800) && (pressCount == 4))
-	{
-		uint8_t highCount = 0;
-		for (uint8_t i; i < 200; i++)
+		else if ((btn_level == HIGH) && (btn_state == BTN_PRESSED))
 		{
-			if (digitalRead(BUTTON_INT_PIN) == HIGH)
-				highCount++;
-			delay(1);
+			btn_state = BTN_RELEASED;
+			btn_change_time = btn_burst_start;
+			btn_clicks++;
 		}
-		if (highCount > 198) // Have no option but to.
+		else if ((btn_level == HIGH) && (btn_state == BTN_HELD))
 		{
-			return QUAD_CLICK;
+			// Release after a long press
+			btn_state = BTN_IDLE;
+			btn_clicks = 0;
+			btn_instant_sent = false;
 		}
 	}
 
-	if (((millis() - pressTime) >= 1200) && (pressCount == 5))
+	// Check the gesture deadlines
+	uint32_t deadline = 0;
+	switch (btn_state)
 	{
-		uint8_t highCount = 0;
-		for (uint8_t i; i < 200; i++)
+	case BTN_PRESSED:
+		if ((now - btn_change_time) >= BTN_LONG_PRESS)
 		{
-			if (digitalRead(BUTTON_INT_PIN) == HIGH)
-				highCount++;
-			delay(1);
+			btn_state = BTN_HELD;
+			btn_clicks = 0;
+			btn_gesture = LONG_PRESS;
 		}
-		if (highCount > 198) // Have no option but to.
+		else
 		{
-			return FIVE_CLICK;
+			deadline = BTN_LONG_PRESS - (now - btn_change_time);
+			// Instant TX, only on the first press of a gesture and outside of the settings UI
+			if ((g_custom_parameters.instant_tx != 0) && (btn_clicks == 0) && !btn_instant_sent && !g_settings_ui)
+			{
+				if ((now - btn_change_time) >= g_custom_parameters.instant_tx)
+				{
+					btn_instant_sent = true;
+					btn_gesture = INSTANT_TX;
+				}
+				else
+				{
+					deadline = g_custom_parameters.instant_tx - (now - btn_change_time);
+				}
+			}
 		}
-	}
-
-	if (((millis() - pressTime) >= 1400) && (pressCount == 6))
-	{
-		uint8_t highCount = 0;
-		for (uint8_t i; i < 200; i++)
+		break;
+	case BTN_RELEASED:
+		if ((now - btn_change_time) >= BTN_CLICK_GAP)
 		{
-			if (digitalRead(BUTTON_INT_PIN) == HIGH)
-				highCount++;
-			delay(1);
+			btn_state = BTN_IDLE;
+			switch (btn_clicks)
+			{
+			case 1:
+				btn_gesture = SINGLE_CLICK;
+				break;
+			case 2:
+				btn_gesture = DOUBLE_CLICK;
+				break;
+			case 3:
+				btn_gesture = TRIPPLE_CLICK;
+				break;
+			case 4:
+				btn_gesture = QUAD_CLICK;
+				break;
+			case 5:
+				btn_gesture = FIVE_CLICK;
+				break;
+			case 6:
+				btn_gesture = SIX_CLICK;
+				break;
+			default:
+				MYLOG("BTN", "%d clicks ignored", btn_clicks);
+				break;
+			}
+			btn_clicks = 0;
 		}
-		if (highCount > 198) // Have no option but to.
+		else
 		{
-			return SIX_CLICK;
+			deadline = BTN_CLICK_GAP - (now - btn_change_time);
 		}
+		break;
+	default:
+		break;
+	}
+
+	if (deadline != 0)
+	{
+		api.system.timer.start(RAK_TIMER_4, deadline, NULL);
+	}
+
+	if (btn_gesture != BUTTONSTATE_NONE)
+	{
+		timer_events |= EVENT_BUTTON;
+	}
+}
+
+/**
+ * @brief Button Status handler
+ *
+ * @return uint8_t decoded gesture, number of clicks or long press detection
+ */
+uint8_t getButtonStatus(void)
+{
+	uint8_t gesture = btn_gesture;
+	btn_gesture = BUTTONSTATE_NONE;
+	return gesture;
+}
+
+/** Number of commit attempts before a reboot is given up */
+#define COMMIT_RETRIES 3
+/** Remaining commit attempts */
+uint8_t commit_retries = 0;
+/** Test mode before the change that requires the reboot */
+uint8_t commit_old_mode = MODE_LINKCHECK;
+
+/**
+ * @brief Settings commit finished, switch the network mode and reboot
+ *     The reboot is only done if the settings are stored in flash.
+ *     If saving fails, the old test mode is restored and the tests continue
+ *
+ * @param result true if the settings were written
+ */
+static void reboot_after_commit(bool result)
+{
+	if (!result)
+	{
+		if (commit_retries > 0)
+		{
+			commit_retries--;
+			oled_add_line((char *)"Saving failed, retry");
+			settings_commit(reboot_after_commit);
+			return;
+		}
+		// Keep running in the old mode, the network mode was not changed
+		g_custom_parameters.test_mode = commit_old_mode;
+		oled_add_line((char *)"Saving failed");
+		oled_add_line((char *)"Reboot cancelled");
+		start_send_timer();
+		return;
+	}
+	oled_add_line((char *)"Settings saved");
+	oled_flush();
+	if (g_custom_parameters.test_mode == MODE_P2P)
+	{
+		api.lora.precv(0);
+		api.lorawan.join(0, 0, 10, 50);
+		api.lora.nwm.set();
+	}
+	else
+	{
+		api.lora.precv(0);
+		api.lorawan.join(1, 1, 10, 50);
+		api.lorawan.nwm.set();
+	}
+	// settings changed, reboot
+	api.system.reboot();
+}
+
+/**
+ * @brief Settings commit finished, show the result
+ *
+ * @param result true if the settings were written
+ */
+static void show_commit_result(bool result)
+{
+	if (has_oled && !g_settings_ui)
+	{
+		oled_add_line(result ? (char *)"Settings saved" : (char *)"Saving failed");
 	}
-	return BUTTONSTATE_NONE;
 }
 
 /**
  * @brief Check changes done in UI
  *     Reboot device if requested changes require it
+ *     Settings are written by the background task, the UI is left immediately
  *
  */
 void save_n_reboot(void)
 {
-	// Test mode changed, force a reboot
+	// Test mode changed, switch between LoRaWAN modes without reboot
+	bool commit = false;
+	bool reboot = false;
+	bool busy = false;
+	commit_old_mode = g_custom_parameters.test_mode;
 	if (g_last_settings.test_mode != g_custom_parameters.test_mode)
+	{
+		uint8_t result = switch_test_mode(g_last_settings.test_mode);
+		reboot = (result == SWITCH_REBOOT);
+		busy = (result == SWITCH_BUSY);
+		commit = !busy;
+	}
+	// Switch between LoRaWAN and LoRa P2P, force a reboot after the settings are saved
+	if (reboot)
 	{
 		oled_clear();
 		oled_write_header("REBOOT");
@@ -244,23 +387,10 @@ void save_n_reboot(void)
 		g_custom_parameters.location_on = g_last_settings.location_on;
 		oled_add_line((char *)"Saving Settings");
 		oled_add_line((char *)"Do not power off");
-		oled_display();
-		save_at_setting();
-		delay(3000);
-		if (g_custom_parameters.test_mode == MODE_P2P)
-		{
-			api.lora.precv(0);
-			api.lorawan.join(0, 0, 10, 50);
-			api.lora.nwm.set();
-		}
-		else
-		{
-			api.lora.precv(0);
-			api.lorawan.join(1, 1, 10, 50);
-			api.lorawan.nwm.set();
-		}
-		// settings changed, reboot
-		api.system.reboot();
+		oled_flush();
+		commit_retries = COMMIT_RETRIES;
+		settings_commit(reboot_after_commit);
+		return;
 	}
 
 	// If location setting has changed, need to initialize the GNSS module
@@ -274,22 +404,19 @@ void save_n_reboot(void)
 		{
 			init_gnss(false);
 		}
+		// init_gnss() leaves the module powered after a restart
+		gnss_power_off();
 	}
 
-	// Other setting changed, save them or apply them
+	// Other setting changed, save them in the background and apply them
 	if ((g_last_settings.send_interval != g_custom_parameters.send_interval) ||
 		(g_last_settings.display_saver != g_custom_parameters.display_saver) ||
 		(g_last_settings.location_on != g_custom_parameters.location_on))
 	{
-		oled_clear();
-		oled_add_line((char *)"Saving Settings");
-		oled_add_line((char *)"Do not power off");
-		oled_display();
 		g_custom_parameters.send_interval = g_last_settings.send_interval;
 		g_custom_parameters.display_saver = g_last_settings.display_saver;
 		g_custom_parameters.location_on = g_last_settings.location_on;
-		save_at_setting();
-		delay(3000);
+		commit = true;
 	}
 	if (api.lorawan.nwm.get())
 	{
@@ -339,6 +466,7 @@ void save_n_reboot(void)
 		// enable receive again
 		api.lora.precv(65533);
 	}
+	status_invalidate();
 	oled_clear();
 
 	switch (g_custom_parameters.test_mode)
@@ -353,39 +481,71 @@ void save_n_reboot(void)
 		oled_add_line((char *)"Field Tester mode");
 		break;
 	}
+	if (busy)
+	{
+		oled_add_line((char *)"TX active, mode kept");
+	}
 	sprintf(line_str, "Test interval %lds", g_custom_parameters.send_interval / 1000);
 	oled_add_line(line_str);
-
-	if (g_custom_parameters.send_interval != 0)
+	if (commit)
 	{
-		api.system.timer.start(RAK_TIMER_0, g_custom_parameters.send_interval, NULL);
+		oled_add_line((char *)"Saving Settings");
+		settings_commit(show_commit_result);
 	}
 
+	start_send_timer();
+
 	if (g_custom_parameters.display_saver)
 	{
 		api.system.timer.start(RAK_TIMER_2, 60000, NULL);
 	}
 }
 
+/**
+ * @brief Start a manual test transmission
+ *     Logs the time from the first button press of the gesture to the TX start
+ *
+ */
+static void manual_send(void)
+{
+	if (tx_active)
+	{
+		return;
+	}
+	if (!display_power)
+	{
+		oled_power(true);
+	}
+	MYLOG("BTN", "Manual send triggered");
+	api.system.timer.stop(RAK_TIMER_0);
+	forced_tx = true;
+	send_packet(NULL);
+	if (gnss_active)
+	{
+		MYLOG("BTN", "Press to TX %ld ms, waiting for location", millis() - btn_gesture_time);
+	}
+	else
+	{
+		MYLOG("BTN", "Press to TX %ld ms", millis() - btn_gesture_time);
+	}
+	start_send_timer();
+}
+
 /**
  * @brief Handle button events
  *     Switch UI display depending on number clicks
  *     Enable/Disable UI display depending on number of clicks
  *     Force Reboot or Bootloader mode, depending on number of clicks
  *     Switch display on/off with long press event
+ *     Manual send with the instant TX gesture
  *
  */
 void handle_button(void)
 {
-	uint8_t selected_item = 0;
-	// char line_str[32];
-
 	switch (getButtonStatus())
 	{
 	case LONG_PRESS:
 	{
-		pressCount = 0;
-		pressTime = 0;
 		MYLOG("BTN", "LongPress");
 		if (display_power)
 		{
@@ -400,355 +560,66 @@ void handle_button(void)
 	}
 	case SIX_CLICK:
 	{
-		pressCount = 0;
-		pressTime = 0;
 		// MYLOG("BTN", "Six Clicks");
 		if (g_settings_ui)
 		{
-			switch (sel_menu)
-			{
-			case T_LORAP2P_MENU:
-				sel_menu = S_P2P_TX;
-				selected_item = ui_p2p_tx;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			}
-			MYLOG("BTN", "6x Menu Level %d", sel_menu);
+			menu_click(6);
 		}
 		break;
 	}
 	case FIVE_CLICK:
 	{
-		pressCount = 0;
-		pressTime = 0;
 		// MYLOG("BTN", "Fice Clicks");
 		if (g_settings_ui)
 		{
-			switch (sel_menu)
-			{
-			case T_TOP_MENU:
-				if (api.lorawan.nwm.get() == 1)
-				{
-					// LoRaWAN settings
-					sel_menu = T_LORAWAN_MENU;
-					display_show_menu(settings_lpw_menu, settings_lpw_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				}
-				else
-				{
-					// LoRaWAN settings
-					sel_menu = T_LORAP2P_MENU;
-					display_show_menu(settings_p2p_menu, settings_p2p_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				}
-				break;
-			case T_LORAWAN_MENU:
-				sel_menu = S_LPW_BAND;
-				selected_item = api.lorawan.band.get();
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_LORAP2P_MENU:
-				sel_menu = S_P2P_CR;
-				selected_item = ui_p2p_cr;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			}
-			MYLOG("BTN", "5x Menu Level %d", sel_menu);
+			menu_click(5);
 		}
 		else
 		{
 			oled_clear();
 			oled_write_header((char *)"BOOTLOADER");
+			oled_flush();
 			udrv_enter_dfu();
 		}
 		break;
 	}
 	case QUAD_CLICK:
 	{
-		pressCount = 0;
-		pressTime = 0;
 		// MYLOG("BTN", "Four Clicks");
 		if (g_settings_ui)
 		{
-			switch (sel_menu)
-			{
-			case T_TOP_MENU:
-				sel_menu = T_MODE_MENU;
-				selected_item = g_last_settings.test_mode + 2;
-				display_show_menu(mode_menu, mode_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_INFO_MENU: // NA
-				sel_menu = T_TOP_MENU;
-				display_show_menu(top_menu, top_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_SETT_MENU:
-				sel_menu = T_SETT_MENU;
-				// Toggle screen saver, not saved
-				g_last_settings.display_saver = !g_last_settings.display_saver;
-				display_show_menu(settings_menu, settings_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_MODE_MENU:
-				g_last_settings.test_mode = MODE_FIELDTESTER;
-				selected_item = g_last_settings.test_mode + 2;
-				display_show_menu(mode_menu, mode_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_LORAWAN_MENU:
-			{
-				sel_menu = S_LPW_TX;
-				uint8_t current_region = api.lorawan.band.get();
-				switch (current_region)
-				{
-				case 0: // EU433
-					ui_min_tx = 0;
-					ui_max_tx = 5;
-					break;
-				case 1:	 // CN470
-				case 2:	 // RU864
-				case 4:	 // EU868
-				case 7:	 // KR920
-				case 8:	 // AS923-1
-				case 9:	 // AS923-2
-				case 10: // AS923-3
-				case 11: // AS923-4
-					ui_min_tx = 0;
-					ui_max_tx = 7;
-					break;
-				case 3:	 // IN865
-				case 5:	 // US915
-				case 6:	 // AU915
-				case 12: // LA915
-					ui_min_tx = 0;
-					ui_max_tx = 10;
-					break;
-				}
-				selected_item = ui_last_dr + 10;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-			}
-			break;
-			case T_LORAP2P_MENU:
-				sel_menu = S_P2P_BW;
-				selected_item = ui_p2p_bw;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_SEND_INT:
-				sel_menu = S_SEND_INT;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			}
-			MYLOG("BTN", "4x Menu Level %d", sel_menu);
+			menu_click(4);
 		}
 		else
 		{
 			oled_clear();
 			oled_write_header((char *)"RESET");
+			oled_flush();
 			api.system.reboot();
 		}
 		break;
 	}
 	case TRIPPLE_CLICK:
 	{
-		pressCount = 0;
-		pressTime = 0;
 		// MYLOG("BTN", "Tripple Click");
 		if (g_settings_ui)
 		{
-			switch (sel_menu)
-			{
-			case T_TOP_MENU:
-				sel_menu = T_SETT_MENU;
-				display_show_menu(settings_menu, settings_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_INFO_MENU: // NA
-				sel_menu = T_TOP_MENU;
-				display_show_menu(top_menu, top_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_SETT_MENU:
-				sel_menu = T_SETT_MENU;
-				// Toggle location, not saved
-				g_last_settings.location_on = !g_last_settings.location_on;
-				display_show_menu(settings_menu, settings_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_MODE_MENU:
-				g_last_settings.test_mode = MODE_P2P;
-				selected_item = g_last_settings.test_mode + 2;
-				display_show_menu(mode_menu, mode_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_LORAWAN_MENU:
-			{
-				sel_menu = S_LPW_DR;
-				uint8_t current_region = api.lorawan.band.get();
-				switch (current_region)
-				{
-				case 0: // EU433
-				case 1: // CN470
-				case 2: // RU864
-				case 3: // IN865
-				case 4: // EU868
-				case 7: // KR920
-					ui_min_dr = 0;
-					ui_max_dr = 5;
-					break;
-				case 5: // US915
-					ui_min_dr = 0;
-					ui_max_dr = 4;
-					break;
-				case 6:	 // AU915
-				case 12: // LA915
-					ui_min_dr = 0;
-					ui_max_dr = 6;
-					break;
-				case 8:	 // AS923-1
-				case 9:	 // AS923-2
-				case 10: // AS923-3
-				case 11: // AS923-4
-					ui_min_dr = 2;
-					ui_max_dr = 5;
-					break;
-				}
-				selected_item = ui_last_dr + 10;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-			}
-			break;
-			case T_LORAP2P_MENU:
-			{
-				sel_menu = S_P2P_SF;
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_sf, g_last_settings.display_saver, g_last_settings.location_on);
-			}
-			break;
-			case S_SEND_INT:
-				sel_menu = S_SEND_INT;
-				if (g_last_settings.send_interval != 0)
-				{
-					if (g_last_settings.send_interval < 10000)
-					{
-						g_last_settings.send_interval = 0;
-					}
-					else
-					{
-						g_last_settings.send_interval -= 10000;
-					}
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_LPW_BAND:
-				sel_menu = S_LPW_BAND;
-				if (ui_last_band == 0)
-				{
-					ui_last_band = 12;
-				}
-				else
-				{
-					ui_last_band -= 1;
-				}
-				MYLOG("BTN", "Region %d", ui_last_band);
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_last_band, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_LPW_DR:
-				sel_menu = S_LPW_DR;
-				if (ui_last_dr == ui_min_dr)
-				{
-					ui_last_dr = ui_max_dr;
-				}
-				else
-				{
-					ui_last_dr -= 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_last_dr, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_LPW_TX:
-				sel_menu = S_LPW_TX;
-				if (ui_last_tx == ui_min_tx)
-				{
-					ui_last_tx = ui_max_tx;
-				}
-				else
-				{
-					ui_last_tx -= 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_last_dr, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_FREQ:
-				sel_menu = S_P2P_FREQ;
-				ui_p2p_freq = ui_p2p_freq - 100000;
-				if (ui_p2p_freq < 430000000)
-				{
-					ui_p2p_freq = 430000000;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_SF:
-				sel_menu = S_P2P_SF;
-				if (ui_p2p_sf == 6)
-				{
-					ui_p2p_sf = 12;
-				}
-				else
-				{
-					ui_p2p_sf = ui_p2p_sf - 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_sf, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_BW:
-				sel_menu = S_P2P_BW;
-				if (ui_p2p_bw == 0)
-				{
-					ui_p2p_bw = 9;
-				}
-				else
-				{
-					ui_p2p_bw = ui_p2p_bw - 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_bw, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_CR:
-				sel_menu = S_P2P_CR;
-				if (ui_p2p_cr == 0)
-				{
-					ui_p2p_cr = 3;
-				}
-				else
-				{
-					ui_p2p_cr = ui_p2p_cr - 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_cr, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_TX:
-				sel_menu = S_P2P_TX;
-				if (ui_p2p_tx == 5)
-				{
-					ui_p2p_tx = 22;
-				}
-				else
-				{
-					ui_p2p_tx = ui_p2p_tx - 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_tx, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			}
-			MYLOG("BTN", "3x Menu Level %d", sel_menu);
+			menu_click(3);
 		}
 		else
 		{
-			if (!tx_active)
-			{
-				if (!display_power)
-				{
-					oled_power(true);
-				}
-				MYLOG("BTN", "Manual send triggered");
-				api.system.timer.stop(RAK_TIMER_0);
-				forced_tx = true;
-				send_packet(NULL);
-				if (g_custom_parameters.send_interval != 0)
-				{
-					api.system.timer.start(RAK_TIMER_0, g_custom_parameters.send_interval, NULL);
-				}
-			}
+			manual_send();
 		}
 		break;
 	}
+	case INSTANT_TX:
+	{
+		MYLOG("BTN", "Instant TX");
+		manual_send();
+		break;
+	}
 	case DOUBLE_CLICK:
 	{
-		pressCount = 0;
-		pressTime = 0;
 		// MYLOG("BTN", "Double Click");
 		if (!g_settings_ui)
 		{
@@ -762,7 +633,6 @@ void handle_button(void)
 			}
 
 			g_settings_ui = true;
-			sel_menu = T_TOP_MENU;
 			g_last_settings.send_interval = g_custom_parameters.send_interval;
 			g_last_settings.test_mode = g_custom_parameters.test_mode;
 			g_last_settings.display_saver = g_custom_parameters.display_saver;
@@ -786,203 +656,34 @@ void handle_button(void)
 				ui_p2p_tx = api.lora.ptp.get();
 				MYLOG("BTN", "F %.3f F %.3f", (long)ui_p2p_freq / 100000000.0, (long)api.lora.pfreq.get() / 100000000.0);
 			}
-			display_show_menu(top_menu, top_menu_len, sel_menu, 0);
+			menu_show(T_TOP_MENU);
 			MYLOG("BTN", "2x Menu Level %d", sel_menu);
 		}
 		else
 		{
-			switch (sel_menu)
-			{
-			case T_TOP_MENU:
-				sel_menu = T_INFO_MENU;
-				display_show_menu(back_menu, back_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_INFO_MENU: // NA
-				sel_menu = T_TOP_MENU;
-				display_show_menu(top_menu, top_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_SETT_MENU:
-				sel_menu = S_SEND_INT;
-				display_show_menu(&back_menu[0], back_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_MODE_MENU:
-				g_last_settings.test_mode = MODE_LINKCHECK;
-				selected_item = g_last_settings.test_mode + 2;
-				display_show_menu(mode_menu, mode_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_LORAWAN_MENU:
-				sel_menu = S_LPW_ADR;
-				selected_item = ui_last_adr + 10;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case T_LORAP2P_MENU:
-				sel_menu = S_P2P_FREQ;
-				display_show_menu(back_menu, back_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_LPW_BAND:
-				sel_menu = S_LPW_BAND;
-				if (ui_last_band == 12)
-				{
-					ui_last_band = 0;
-				}
-				else
-				{
-					ui_last_band += 1;
-				}
-				MYLOG("BTN", "Region %d", ui_last_band);
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_last_band, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_LPW_ADR:
-				sel_menu = S_LPW_ADR;
-				if (ui_last_adr == 0)
-				{
-					ui_last_adr = 1;
-				}
-				else
-				{
-					ui_last_adr = 0;
-				}
-				selected_item = ui_last_adr + 10;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_LPW_DR:
-				sel_menu = S_LPW_DR;
-				if (ui_last_dr == ui_max_dr)
-				{
-					ui_last_dr = ui_min_dr;
-				}
-				else
-				{
-					ui_last_dr += 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_last_dr, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_LPW_TX:
-				sel_menu = S_LPW_TX;
-				if (ui_last_tx == ui_max_tx)
-				{
-					ui_last_tx = ui_min_tx;
-				}
-				else
-				{
-					ui_last_tx += 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_last_tx, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_FREQ:
-				sel_menu = S_P2P_FREQ;
-				ui_p2p_freq = ui_p2p_freq + 100000;
-				if (ui_p2p_freq > 960000000)
-				{
-					ui_p2p_freq = 960000000;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_SF:
-				sel_menu = S_P2P_SF;
-				if (ui_p2p_sf == 12)
-				{
-					ui_p2p_sf = 6;
-				}
-				else
-				{
-					ui_p2p_sf = ui_p2p_sf + 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_sf, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_BW:
-				sel_menu = S_P2P_BW;
-				if (ui_p2p_bw == 9)
-				{
-					ui_p2p_bw = 0;
-				}
-				else
-				{
-					ui_p2p_bw = ui_p2p_bw + 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_bw, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_CR:
-				sel_menu = S_P2P_CR;
-				if (ui_p2p_cr == 3)
-				{
-					ui_p2p_cr = 0;
-				}
-				else
-				{
-					ui_p2p_cr = ui_p2p_cr + 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_cr, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_TX:
-				sel_menu = S_P2P_TX;
-				if (ui_p2p_tx == 22)
-				{
-					ui_p2p_tx = 5;
-				}
-				else
-				{
-					ui_p2p_tx = ui_p2p_tx + 1;
-				}
-				display_show_menu(back_menu, back_menu_len, sel_menu, ui_p2p_tx, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_SEND_INT:
-				sel_menu = S_SEND_INT;
-				g_last_settings.send_interval += 10000;
-				display_show_menu(back_menu, back_menu_len, sel_menu, selected_item, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			}
-			MYLOG("BTN", "2x Menu Level %d", sel_menu);
+			menu_click(2);
 		}
 		break;
 	}
 	case SINGLE_CLICK:
 	{
-		pressCount = 0;
-		pressTime = 0;
 		// MYLOG("BTN", "Single Click");
 		if (g_settings_ui)
 		{
-			switch (sel_menu)
-			{
-			case T_TOP_MENU:
-				// Exit menu
-				g_settings_ui = false;
-				save_n_reboot();
-				break;
-			case T_INFO_MENU:
-			case T_SETT_MENU:
-			case T_MODE_MENU:
-			case T_LORAWAN_MENU:
-			case T_LORAP2P_MENU:
-				sel_menu = T_TOP_MENU;
-				display_show_menu(top_menu, top_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_LPW_BAND:
-			case S_LPW_ADR:
-			case S_LPW_DR:
-			case S_LPW_TX:
-				sel_menu = T_LORAWAN_MENU;
-				display_show_menu(settings_lpw_menu, settings_lpw_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_P2P_FREQ:
-			case S_P2P_SF:
-			case S_P2P_BW:
-			case S_P2P_CR:
-			case S_P2P_TX:
-				sel_menu = T_LORAP2P_MENU;
-				display_show_menu(settings_p2p_menu, settings_p2p_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			case S_SEND_INT:
-				sel_menu = T_SETT_MENU;
-				display_show_menu(settings_menu, settings_menu_len, sel_menu, 255, g_last_settings.display_saver, g_last_settings.location_on);
-				break;
-			}
-			MYLOG("BTN", "1x Menu Level %d", sel_menu);
+			menu_click(1);
 		}
-		else
+		else if (has_oled)
 		{
-
+			if (!display_power)
+			{
+				oled_power(true);
+			}
+			else
+			{
+				// Switch between text and RSSI/SNR graph view
+				graph_toggle();
+				MYLOG("BTN", "Graph view %s", g_graph_view ? "on" : "off");
+			}
 		}
 		break;
 	}
@@ -0,0 +1,310 @@
+/**
+ * @file coverage.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Coverage grid of Field Tester results
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Size of a grid cell in latitude, 50 meters in 1e-7 degrees */
+#define GRID_CELL_LAT 4492
+
+/** The coverage grid, open addressing hash map */
+grid_cell_s coverage_grid[GRID_SIZE];
+/** Number of used cells */
+uint16_t g_grid_used = 0;
+/** Number of samples dropped because the grid was full */
+uint16_t g_grid_dropped = 0;
+
+/** Number of recently tested cells kept in the LRU cache */
+#define RECENT_SIZE 16
+/** Samples older than this are not counted as recent (30 minutes) */
+#define RECENT_MAX_AGE 1800000
+/** Minimum time between two tests in a covered cell (5 minutes) */
+#define RECENT_RETEST 300000
+
+/** Recently tested cell */
+struct recent_cell_s
+{
+	int32_t lat_idx;	// Row of the cell
+	int32_t long_idx;	// Column of the cell
+	uint8_t samples;	// Number of recent samples
+	uint32_t last_test; // Time of the last sample
+};
+
+/** LRU cache of recently tested cells, most recent first */
+recent_cell_s recent_cells[RECENT_SIZE];
+/** Number of used entries in the LRU cache */
+uint8_t recent_used = 0;
+
+/**
+ * @brief Division rounding towards negative infinity
+ *
+ * @param value dividend
+ * @param divider divider (positive)
+ * @return int32_t floor(value / divider)
+ */
+static int32_t floor_div(int32_t value, int32_t divider)
+{
+	int32_t result = value / divider;
+	if ((value % divider != 0) && (value < 0))
+	{
+		result--;
+	}
+	return result;
+}
+
+/**
+ * @brief Get the size of a cell in longitude for a row of the grid
+ *     Cells keep their size in meters independent of the latitude
+ *
+ * @param lat_idx row of the grid
+ * @return int32_t cell size in 1e-7 degrees longitude
+ */
+static int32_t coverage_long_step(int32_t lat_idx)
+{
+	int32_t cos_lat = gnss_cos_q15(lat_idx * GRID_CELL_LAT + GRID_CELL_LAT / 2);
+	// Close to the poles the cells grow to max 1 degree
+	if (cos_lat < 147)
+	{
+		return 10000000;
+	}
+	return (int32_t)(((int64_t)GRID_CELL_LAT << 15) / cos_lat);
+}
+
+/**
+ * @brief Get the grid cell of a location
+ *
+ * @param lat latitude in 1e-7 degrees
+ * @param lon longitude in 1e-7 degrees
+ * @param lat_idx returns the row of the cell
+ * @param long_idx returns the column of the cell
+ */
+void coverage_cell(int32_t lat, int32_t lon, int32_t *lat_idx, int32_t *long_idx)
+{
+	*lat_idx = floor_div(lat, GRID_CELL_LAT);
+	*long_idx = floor_div(lon, coverage_long_step(*lat_idx));
+}
+
+/**
+ * @brief Get the center of a grid cell
+ *
+ * @param cell grid cell
+ * @param lat returns the latitude of the center in 1e-7 degrees
+ * @param lon returns the longitude of the center in 1e-7 degrees
+ */
+void coverage_cell_center(grid_cell_s *cell, int32_t *lat, int32_t *lon)
+{
+	int32_t long_step = coverage_long_step(cell->lat_idx);
+	*lat = cell->lat_idx * GRID_CELL_LAT + GRID_CELL_LAT / 2;
+	*lon = cell->long_idx * long_step + long_step / 2;
+}
+
+/**
+ * @brief Find the grid slot of a cell
+ *
+ * @param lat_idx row of the cell
+ * @param long_idx column of the cell
+ * @return grid_cell_s* pointer to the cell or to an empty slot, NULL if the grid is full
+ */
+static grid_cell_s *coverage_find(int32_t lat_idx, int32_t long_idx)
+{
+	uint32_t hash = ((uint32_t)lat_idx * 73856093U) ^ ((uint32_t)long_idx * 19349663U);
+	for (uint16_t probe = 0; probe < GRID_SIZE; probe++)
+	{
+		grid_cell_s *cell = &coverage_grid[(hash + probe) & (GRID_SIZE - 1)];
+		if ((cell->count == 0) || ((cell->lat_idx == lat_idx) && (cell->long_idx == long_idx)))
+		{
+			return cell;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Find a cell in the LRU cache of recently tested cells
+ *
+ * @param lat_idx row of the cell
+ * @param long_idx column of the cell
+ * @return int index in the cache or -1 if not found
+ */
+static int coverage_recent_find(int32_t lat_idx, int32_t long_idx)
+{
+	for (int idx = 0; idx < recent_used; idx++)
+	{
+		if ((recent_cells[idx].lat_idx == lat_idx) && (recent_cells[idx].long_idx == long_idx))
+		{
+			return idx;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief Count a sample in the LRU cache of recently tested cells
+ *     The cell is moved to the front, the least recently tested cell is dropped if the cache is full
+ *
+ * @param lat_idx row of the cell
+ * @param long_idx column of the cell
+ */
+static void coverage_recent_add(int32_t lat_idx, int32_t long_idx)
+{
+	recent_cell_s entry = {lat_idx, long_idx, 0, 0};
+	int idx = coverage_recent_find(lat_idx, long_idx);
+	if (idx < 0)
+	{
+		idx = (recent_used < RECENT_SIZE) ? recent_used++ : RECENT_SIZE - 1;
+	}
+	else
+	{
+		entry = recent_cells[idx];
+	}
+
+	// Old samples do not count as recent
+	if ((millis() - entry.last_test) > RECENT_MAX_AGE)
+	{
+		entry.samples = 0;
+	}
+	if (entry.samples < 0xFF)
+	{
+		entry.samples++;
+	}
+	entry.last_test = millis();
+
+	memmove(&recent_cells[1], &recent_cells[0], idx * sizeof(recent_cell_s));
+	recent_cells[0] = entry;
+}
+
+/**
+ * @brief Check if a Field Tester uplink at a position can be skipped
+ *     because the cell was already tested often enough.
+ *     In a covered cell only one test every 5 minutes is sent.
+ *     Disabled with ATC+SKIPCOV=0. A manual send is never skipped,
+ *     the caller checks forced_tx.
+ *
+ * @param lat latitude in 1e-7 degrees
+ * @param lon longitude in 1e-7 degrees
+ * @return true if the uplink should be skipped
+ */
+bool coverage_skip(int32_t lat, int32_t lon)
+{
+	if ((g_custom_parameters.skip_covered == 0) || ((lat == 0) && (lon == 0)))
+	{
+		return false;
+	}
+
+	int32_t lat_idx;
+	int32_t long_idx;
+	coverage_cell(lat, lon, &lat_idx, &long_idx);
+	int idx = coverage_recent_find(lat_idx, long_idx);
+	if (idx < 0)
+	{
+		return false;
+	}
+
+	uint32_t age = millis() - recent_cells[idx].last_test;
+	if ((recent_cells[idx].samples < g_custom_parameters.skip_covered) || (age > RECENT_RETEST))
+	{
+		return false;
+	}
+	MYLOG("GRID", "Cell %ld/%ld covered with %d samples, skip", lat_idx, long_idx, recent_cells[idx].samples);
+	return true;
+}
+
+/**
+ * @brief Add a Field Tester result to the coverage grid
+ *
+ * @param lat latitude in 1e-7 degrees
+ * @param lon longitude in 1e-7 degrees
+ * @param rssi best RSSI reported by the gateways
+ * @param gateways number of gateways that received the uplink
+ */
+void coverage_add(int32_t lat, int32_t lon, int16_t rssi, uint8_t gateways)
+{
+	if ((lat == 0) && (lon == 0))
+	{
+		return;
+	}
+
+	int32_t lat_idx;
+	int32_t long_idx;
+	coverage_cell(lat, lon, &lat_idx, &long_idx);
+	coverage_recent_add(lat_idx, long_idx);
+
+	grid_cell_s *cell = coverage_find(lat_idx, long_idx);
+	if (cell == NULL)
+	{
+		g_grid_dropped++;
+		MYLOG("GRID", "Grid full, sample dropped");
+		return;
+	}
+
+	if (cell->count == 0)
+	{
+		cell->lat_idx = lat_idx;
+		cell->long_idx = long_idx;
+		cell->rssi_min = rssi;
+		cell->rssi_max = rssi;
+		cell->rssi_sum = 0;
+		cell->gw_min = gateways;
+		cell->gw_max = gateways;
+		cell->gw_sum = 0;
+		g_grid_used++;
+	}
+	if (rssi < cell->rssi_min)
+	{
+		cell->rssi_min = rssi;
+	}
+	if (rssi > cell->rssi_max)
+	{
+		cell->rssi_max = rssi;
+	}
+	if (gateways < cell->gw_min)
+	{
+		cell->gw_min = gateways;
+	}
+	if (gateways > cell->gw_max)
+	{
+		cell->gw_max = gateways;
+	}
+	if (cell->count == 0xFFFF)
+	{
+		// Saturated, keep min/max only
+		return;
+	}
+	cell->count++;
+	cell->rssi_sum += rssi;
+	cell->gw_sum += gateways;
+	MYLOG("GRID", "Cell %ld/%ld samples %d", lat_idx, long_idx, cell->count);
+}
+
+/**
+ * @brief Get a used slot of the coverage grid
+ *
+ * @param slot slot number 0 to GRID_SIZE - 1
+ * @return grid_cell_s* pointer to the cell or NULL if the slot is empty or invalid
+ */
+grid_cell_s *coverage_slot(uint16_t slot)
+{
+	if ((slot >= GRID_SIZE) || (coverage_grid[slot].count == 0))
+	{
+		return NULL;
+	}
+	return &coverage_grid[slot];
+}
+
+/**
+ * @brief Clear the coverage grid
+ *
+ */
+void coverage_clear(void)
+{
+	memset(coverage_grid, 0, sizeof(coverage_grid));
+	g_grid_used = 0;
+	g_grid_dropped = 0;
+	recent_used = 0;
+}
@@ -38,6 +38,15 @@ int interval_send_handler(SERIAL_PORT port, char *cmd, stParam *param);
 int status_handler(SERIAL_PORT port, char *cmd, stParam *param);
 int test_mode_handler(SERIAL_PORT port, char *cmd, stParam *param);
 int custom_pckg_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int send_distance_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int grid_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int skip_covered_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int log_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int telemetry_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int oled_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int instant_tx_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int profile_handler(SERIAL_PORT port, char *cmd, stParam *param);
+int stats_handler(SERIAL_PORT port, char *cmd, stParam *param);
 
 /**
  * @brief Add send interval AT command
@@ -88,13 +97,8 @@ int interval_send_handler(SERIAL_PORT port, char *cmd, stParam *param)
 		g_custom_parameters.send_interval = new_send_freq * 1000;
 
 		MYLOG("AT_CMD", "New interval %ld", g_custom_parameters.send_interval);
-		// Stop the timer
-		api.system.timer.stop(RAK_TIMER_0);
-		if (g_custom_parameters.send_interval != 0)
-		{
-			// Restart the timer
-			api.system.timer.start(RAK_TIMER_0, g_custom_parameters.send_interval, NULL);
-		}
+		// Restart the timer with the new interval
+		start_send_timer();
 		// Save custom settings
 		save_at_setting();
 	}
@@ -160,39 +164,24 @@ int test_mode_handler(SERIAL_PORT port, char *cmd, stParam *param)
 
 		if (new_mode != old_mode)
 		{
-			bool restart = true;
-			if (((old_mode == 0) && (new_mode == 1)) || ((old_mode == 1) && (new_mode == 0)))
+			// Switch mode, within the LoRaWAN modes without restart
+			uint8_t result = switch_test_mode(new_mode);
+			if (result == SWITCH_BUSY)
 			{
-				MYLOG("AT_CMD", "Switch within LPWAN modes");
-				restart = false;
+				return AT_BUSY_ERROR;
 			}
-
-			g_custom_parameters.test_mode = new_mode;
+			bool restart = (result == SWITCH_REBOOT);
 			MYLOG("AT_CMD", "New test mode %ld", g_custom_parameters.test_mode);
 
 			// Save custom settings
 			save_at_setting();
 
-			// Switch mode
-			switch (g_custom_parameters.test_mode)
-			{
-			case MODE_LINKCHECK:
-				set_linkcheck();
-				break;
-			case MODE_P2P:
-				set_p2p();
-				break;
-			case MODE_FIELDTESTER:
-				set_field_tester();
-				break;
-			}
-
 			// If switching between LoRaWAN and LoRa P2P the device needs to restart
 			if (restart)
 			{
 				AT_PRINTF("+EVT:RESTART_FOR_MODE_CHANGE");
 				delay(5000);
-				api.system.reboot();
+				restart_test_mode();
 			}
 		}
 	}
@@ -213,7 +202,7 @@ int test_mode_handler(SERIAL_PORT port, char *cmd, stParam *param)
 bool init_custom_pckg_at(void)
 {
 	return api.system.atMode.add((char *)"PCKG",
-								 (char *)"Set/Get a custom packet (max 64 bytes)",
+								 (char *)"Set/Get a custom packet (max 64 bytes) or a generated packet GEN,<fields CURSP>,<min len>,<max len>,<step>",
 								 (char *)"PCKG", custom_pckg_handler,
 								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
 }
@@ -233,7 +222,12 @@ int custom_pckg_handler(SERIAL_PORT port, char *cmd, stParam *param)
 	char temp_str[257];
 	if (param->argc == 1 && !strcmp(param->argv[0], "?"))
 	{
-		if (g_custom_parameters.custom_packet_len == 0)
+		if (g_custom_parameters.pckg_fields[0] != 0)
+		{
+			AT_PRINTF("%s=GEN,%s,%d,%d,%d", cmd, g_custom_parameters.pckg_fields, g_custom_parameters.pckg_min,
+					  g_custom_parameters.pckg_max, g_custom_parameters.pckg_step);
+		}
+		else if (g_custom_parameters.custom_packet_len == 0)
 		{
 			AT_PRINTF("%s=01020304", cmd);
 		}
@@ -258,6 +252,167 @@ int custom_pckg_handler(SERIAL_PORT port, char *cmd, stParam *param)
 		}
 
 		g_custom_parameters.custom_packet_len = len / 2;
+		// A fixed packet switches the generator off
+		g_custom_parameters.pckg_fields[0] = 0;
+
+		// Save custom settings
+		save_at_setting();
+	}
+	else if ((param->argc == 5) && !strcmp(param->argv[0], "GEN"))
+	{
+		uint32_t sizes[3];
+		for (int arg = 2; arg < 5; arg++)
+		{
+			for (int i = 0; i < strlen(param->argv[arg]); i++)
+			{
+				if (!isdigit(*(param->argv[arg] + i)))
+				{
+					MYLOG("AT_CMD", "%d is no digit", i);
+					return AT_PARAM_ERROR;
+				}
+			}
+			sizes[arg - 2] = strtoul(param->argv[arg], NULL, 10);
+			if (sizes[arg - 2] > 128)
+			{
+				return AT_PARAM_ERROR;
+			}
+		}
+		if ((strlen(param->argv[1]) > PCKG_FIELDS_MAX) || !payload_check(param->argv[1], sizes[0], sizes[1], sizes[2]))
+		{
+			MYLOG("AT_CMD", "Invalid generator fields or sizes");
+			return AT_PARAM_ERROR;
+		}
+
+		strcpy(g_custom_parameters.pckg_fields, param->argv[1]);
+		g_custom_parameters.pckg_min = sizes[0];
+		g_custom_parameters.pckg_max = sizes[1];
+		g_custom_parameters.pckg_step = sizes[2];
+		payload_reset();
+		MYLOG("AT_CMD", "New packet generator %s %d-%d", g_custom_parameters.pckg_fields, g_custom_parameters.pckg_min, g_custom_parameters.pckg_max);
+
+		// Save custom settings
+		save_at_setting();
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+
+	return AT_OK;
+}
+
+/**
+ * @brief Add send distance AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_send_distance_at(void)
+{
+	return api.system.atMode.add((char *)"SENDDIST",
+								 (char *)"Set/Get the distance in meters that triggers a Field Tester uplink 0 = off, max 10000 meters",
+								 (char *)"SENDDIST", send_distance_handler,
+								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Handler for send distance AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ */
+int send_distance_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if (param->argc == 1 && !strcmp(param->argv[0], "?"))
+	{
+		AT_PRINTF("%s=%d", cmd, g_custom_parameters.send_distance);
+	}
+	else if (param->argc == 1)
+	{
+		MYLOG("AT_CMD", "param->argv[0] >> %s", param->argv[0]);
+		for (int i = 0; i < strlen(param->argv[0]); i++)
+		{
+			if (!isdigit(*(param->argv[0] + i)))
+			{
+				MYLOG("AT_CMD", "%d is no digit", i);
+				return AT_PARAM_ERROR;
+			}
+		}
+
+		uint32_t new_distance = strtoul(param->argv[0], NULL, 10);
+		if (new_distance > 10000)
+		{
+			return AT_PARAM_ERROR;
+		}
+
+		g_custom_parameters.send_distance = new_distance;
+		MYLOG("AT_CMD", "New send distance %d", g_custom_parameters.send_distance);
+
+		// Save custom settings
+		save_at_setting();
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+
+	return AT_OK;
+}
+
+/**
+ * @brief Add skip covered cells AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_skip_covered_at(void)
+{
+	return api.system.atMode.add((char *)"SKIPCOV",
+								 (char *)"Set/Get the number of recent samples after which a cell is tested only every 5 minutes 0 = off, max 20",
+								 (char *)"SKIPCOV", skip_covered_handler,
+								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Handler for skip covered cells AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ */
+int skip_covered_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if (param->argc == 1 && !strcmp(param->argv[0], "?"))
+	{
+		AT_PRINTF("%s=%d", cmd, g_custom_parameters.skip_covered);
+	}
+	else if (param->argc == 1)
+	{
+		MYLOG("AT_CMD", "param->argv[0] >> %s", param->argv[0]);
+		for (int i = 0; i < strlen(param->argv[0]); i++)
+		{
+			if (!isdigit(*(param->argv[0] + i)))
+			{
+				MYLOG("AT_CMD", "%d is no digit", i);
+				return AT_PARAM_ERROR;
+			}
+		}
+
+		uint32_t new_samples = strtoul(param->argv[0], NULL, 10);
+		if (new_samples > 20)
+		{
+			return AT_PARAM_ERROR;
+		}
+
+		g_custom_parameters.skip_covered = new_samples;
+		MYLOG("AT_CMD", "New skip covered samples %d", g_custom_parameters.skip_covered);
 
 		// Save custom settings
 		save_at_setting();
@@ -270,6 +425,483 @@ int custom_pckg_handler(SERIAL_PORT port, char *cmd, stParam *param)
 	return AT_OK;
 }
 
+/**
+ * @brief Add coverage grid AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_grid_at(void)
+{
+	return api.system.atMode.add((char *)"GRID",
+								 (char *)"Get the coverage grid (lat,long,samples,RSSI min,max,mean,GW min,max,mean) or clear it with 0",
+								 (char *)"GRID", grid_handler,
+								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Handler for coverage grid AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ */
+int grid_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if ((param->argc == 1 && !strcmp(param->argv[0], "?")) || (param->argc == 0))
+	{
+		AT_PRINTF("%s=%d,%d", cmd, g_grid_used, g_grid_dropped);
+		char location_str[32];
+		for (uint16_t slot = 0; slot < GRID_SIZE; slot++)
+		{
+			grid_cell_s *cell = coverage_slot(slot);
+			if (cell == NULL)
+			{
+				continue;
+			}
+			int32_t lat;
+			int32_t lon;
+			coverage_cell_center(cell, &lat, &lon);
+			fmt_location(location_str, "", ",", lat, lon, 5);
+			// Serial output only, AT_PRINTF adds 100ms delay per line
+			atcmd_printf("%s,%d,%d,%d,%ld,%d,%d,%ld.%ld\r\n", location_str, cell->count,
+						 cell->rssi_min, cell->rssi_max, cell->rssi_sum / cell->count,
+						 cell->gw_min, cell->gw_max, cell->gw_sum / cell->count, (cell->gw_sum * 10 / cell->count) % 10);
+		}
+	}
+	else if (param->argc == 1 && !strcmp(param->argv[0], "0"))
+	{
+		coverage_clear();
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+
+	return AT_OK;
+}
+
+/**
+ * @brief Add result log AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_log_at(void)
+{
+	return api.system.atMode.add((char *)"LOG",
+								 (char *)"Get the number of logged results, read <first>,<number> results (max 50) or erase the log with ERASE",
+								 (char *)"LOG", log_handler,
+								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Handler for result log AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ */
+int log_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if (param->argc == 1 && !strcmp(param->argv[0], "?"))
+	{
+		log_flush();
+		AT_PRINTF("%s=%d", cmd, g_log_count);
+	}
+	else if (param->argc == 1 && !strcmp(param->argv[0], "ERASE"))
+	{
+		log_erase();
+	}
+	else if (param->argc == 2)
+	{
+		for (int arg = 0; arg < 2; arg++)
+		{
+			for (int i = 0; i < strlen(param->argv[arg]); i++)
+			{
+				if (!isdigit(*(param->argv[arg] + i)))
+				{
+					MYLOG("AT_CMD", "%d is no digit", i);
+					return AT_PARAM_ERROR;
+				}
+			}
+		}
+		uint32_t first = strtoul(param->argv[0], NULL, 10);
+		uint32_t number = strtoul(param->argv[1], NULL, 10);
+		if (number > 50)
+		{
+			return AT_PARAM_ERROR;
+		}
+
+		log_flush();
+		log_record_s record;
+		// Index, sequence, time, mode, RSSI, SNR, margin, gateways, latitude, longitude
+		for (uint32_t index = first; (index < first + number) && (index < g_log_count); index++)
+		{
+			if (!log_read(index, &record))
+			{
+				atcmd_printf("%ld,CRC\r\n", index);
+				continue;
+			}
+			char location_str[32];
+			fmt_location(location_str, "", ",", record.lat, record.lon, 7);
+			atcmd_printf("%ld,%ld,%ld,%d,%d,%d,%d,%d,%s\r\n", index, record.seq, record.time, record.mode,
+						 record.rssi, record.snr, record.margin, record.gateways, location_str);
+		}
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+
+	return AT_OK;
+}
+
+/**
+ * @brief Add binary telemetry AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_telemetry_at(void)
+{
+	return api.system.atMode.add((char *)"TLM",
+								 (char *)"Set/Get binary telemetry output of test results 0 = text, 1 = binary",
+								 (char *)"TLM", telemetry_handler,
+								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Handler for binary telemetry AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ */
+int telemetry_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if (param->argc == 1 && !strcmp(param->argv[0], "?"))
+	{
+		AT_PRINTF("%s=%d", cmd, g_custom_parameters.telemetry ? 1 : 0);
+	}
+	else if (param->argc == 1)
+	{
+		if (!strcmp(param->argv[0], "0"))
+		{
+			g_custom_parameters.telemetry = false;
+		}
+		else if (!strcmp(param->argv[0], "1"))
+		{
+			g_custom_parameters.telemetry = true;
+		}
+		else
+		{
+			return AT_PARAM_ERROR;
+		}
+		MYLOG("AT_CMD", "New telemetry mode %s", g_custom_parameters.telemetry ? "binary" : "text");
+
+		// Save custom settings
+		save_at_setting();
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+
+	return AT_OK;
+}
+
+/**
+ * @brief Add display debug AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_oled_at(void)
+{
+	return api.system.atMode.add((char *)"OLED",
+								 (char *)"Get display statistics (updates,I2C bytes,last update bytes,last update us), DUMP the display as PBM or reset the statistics with 0",
+								 (char *)"OLED", oled_handler,
+								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Handler for display debug AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ */
+int oled_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if (!has_oled)
+	{
+		return AT_ERROR;
+	}
+	if (param->argc == 1 && !strcmp(param->argv[0], "?"))
+	{
+		uint32_t flushes;
+		uint32_t bytes;
+		uint32_t last_bytes;
+		uint32_t last_time;
+		oled_get_stats(&flushes, &bytes, &last_bytes, &last_time);
+		AT_PRINTF("%s=%ld,%ld,%ld,%ld", cmd, flushes, bytes, last_bytes, last_time);
+	}
+	else if (param->argc == 1 && !strcmp(param->argv[0], "DUMP"))
+	{
+		// Plain PBM, rows split in 2 lines to stay below 70 characters per line
+		char line[129];
+		atcmd_printf("P1\r\n128 64\r\n");
+		for (uint8_t row = 0; row < 64; row++)
+		{
+			oled_get_row(row, line);
+			atcmd_printf("%.64s\r\n%s\r\n", line, &line[64]);
+		}
+	}
+	else if (param->argc == 1 && !strcmp(param->argv[0], "0"))
+	{
+		oled_reset_stats();
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+
+	return AT_OK;
+}
+
+/**
+ * @brief Add instant TX AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_instant_tx_at(void)
+{
+	return api.system.atMode.add((char *)"ITX",
+								 (char *)"Set/Get the button hold time in ms that starts a test transmission 0 = off, 100 to 2500",
+								 (char *)"ITX", instant_tx_handler,
+								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Handler for instant TX AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ */
+int instant_tx_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if (param->argc == 1 && !strcmp(param->argv[0], "?"))
+	{
+		AT_PRINTF("%s=%d", cmd, g_custom_parameters.instant_tx);
+	}
+	else if (param->argc == 1)
+	{
+		MYLOG("AT_CMD", "param->argv[0] >> %s", param->argv[0]);
+		for (int i = 0; i < strlen(param->argv[0]); i++)
+		{
+			if (!isdigit(*(param->argv[0] + i)))
+			{
+				MYLOG("AT_CMD", "%d is no digit", i);
+				return AT_PARAM_ERROR;
+			}
+		}
+
+		uint32_t new_hold_time = strtoul(param->argv[0], NULL, 10);
+		if ((new_hold_time != 0) && ((new_hold_time < 100) || (new_hold_time > INSTANT_TX_MAX)))
+		{
+			return AT_PARAM_ERROR;
+		}
+
+		g_custom_parameters.instant_tx = new_hold_time;
+		MYLOG("AT_CMD", "New instant TX hold time %d", g_custom_parameters.instant_tx);
+
+		// Save custom settings
+		save_at_setting();
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+
+	return AT_OK;
+}
+
+/**
+ * @brief Add test profile AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_profile_at(void)
+{
+	return api.system.atMode.add((char *)"PROF",
+								 (char *)"List the test profiles, apply profile <1-4>, save the current settings with SAVE,<1-4>,<name> or delete with DEL,<1-4>",
+								 (char *)"PROF", profile_handler,
+								 RAK_ATCMD_PERM_WRITE | RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Get the profile slot from an AT command parameter
+ *
+ * @param param parameter with the profile number 1 to PROFILE_MAX
+ * @return uint8_t profile slot or PROFILE_NONE if invalid
+ */
+static uint8_t profile_slot(char *param)
+{
+	if ((strlen(param) != 1) || (param[0] < '1') || (param[0] > '0' + PROFILE_MAX))
+	{
+		return PROFILE_NONE;
+	}
+	return param[0] - '1';
+}
+
+/**
+ * @brief Handler for test profile AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ * 			AT_ERROR profile could not be written
+ */
+int profile_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if ((param->argc == 1 && !strcmp(param->argv[0], "?")) || (param->argc == 0))
+	{
+		profile_s profile;
+		for (uint8_t slot = 0; slot < PROFILE_MAX; slot++)
+		{
+			if (profile_get(slot, &profile))
+			{
+				AT_PRINTF("%s=%d,%s,%d,%ld", cmd, slot + 1, profile.name, profile.test_mode, profile.send_interval / 1000);
+			}
+			else
+			{
+				AT_PRINTF("%s=%d,empty", cmd, slot + 1);
+			}
+		}
+	}
+	else if (param->argc == 1)
+	{
+		uint8_t slot = profile_slot(param->argv[0]);
+		bool restart = false;
+		if (slot == PROFILE_NONE)
+		{
+			return AT_PARAM_ERROR;
+		}
+		if (!profile_apply(slot, &restart))
+		{
+			// Empty slot or uplink in progress for a mode change
+			return tx_active ? AT_BUSY_ERROR : AT_PARAM_ERROR;
+		}
+		if (restart)
+		{
+			AT_PRINTF("+EVT:RESTART_FOR_MODE_CHANGE");
+			delay(5000);
+			restart_test_mode();
+		}
+	}
+	else if ((param->argc == 3) && !strcmp(param->argv[0], "SAVE"))
+	{
+		uint8_t slot = profile_slot(param->argv[1]);
+		uint8_t len = strlen(param->argv[2]);
+		if ((slot == PROFILE_NONE) || (len == 0) || (len >= PROFILE_NAME_LEN))
+		{
+			return AT_PARAM_ERROR;
+		}
+		for (int i = 0; i < len; i++)
+		{
+			if (!isalnum(param->argv[2][i]) && (param->argv[2][i] != '-') && (param->argv[2][i] != '_'))
+			{
+				MYLOG("AT_CMD", "%d is no valid name character", i);
+				return AT_PARAM_ERROR;
+			}
+		}
+		if (!profile_store(slot, param->argv[2]))
+		{
+			return AT_ERROR;
+		}
+	}
+	else if ((param->argc == 2) && !strcmp(param->argv[0], "DEL"))
+	{
+		uint8_t slot = profile_slot(param->argv[1]);
+		if (slot == PROFILE_NONE)
+		{
+			return AT_PARAM_ERROR;
+		}
+		if (!profile_delete(slot))
+		{
+			return AT_ERROR;
+		}
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+
+	return AT_OK;
+}
+
+/**
+ * @brief Add machine readable status AT command
+ *
+ * @return true if success
+ * @return false if failed
+ */
+bool init_stats_at(void)
+{
+	return api.system.atMode.add((char *)"STATS",
+								 (char *)"Get settings, radio settings, link statistics and counters as one line of key=value pairs",
+								 (char *)"STATS", stats_handler,
+								 RAK_ATCMD_PERM_READ);
+}
+
+/**
+ * @brief Handler for machine readable status AT command
+ *
+ * @param port Serial port used
+ * @param cmd char array with the received AT command
+ * @param param char array with the received AT command parameters
+ * @return int result of command parsing
+ * 			AT_OK AT command & parameters valid
+ * 			AT_PARAM_ERROR command or parameters invalid
+ */
+int stats_handler(SERIAL_PORT port, char *cmd, stParam *param)
+{
+	if ((param->argc == 1 && !strcmp(param->argv[0], "?")) || (param->argc == 0))
+	{
+		char status_str[STATUS_LINE_SIZE];
+		status_line(status_str);
+		// One line, AT_PRINTF adds 100ms delay per line
+		AT_PRINTF("%s=%s", cmd, status_str);
+	}
+	else
+	{
+		return AT_PARAM_ERROR;
+	}
+	return AT_OK;
+}
+
 /**
  * @brief Add custom Status AT command
  *
@@ -378,9 +1010,29 @@ int status_handler(SERIAL_PORT port, char *cmd, stParam *param)
 			AT_PRINTF("Bitrate = %d", api.lora.pbr.get());
 			AT_PRINTF("Deviaton = %d", api.lora.pfdev.get());
 		}
+		AT_PRINTF("Battery = %d.%03dV %d%%", g_battery_mv / 1000, g_battery_mv % 1000, g_battery_soc);
 		AT_PRINTF("Custom settings");
 		AT_PRINTF("Testmode = %d", g_custom_parameters.test_mode);
 		AT_PRINTF("Display saver %s", g_custom_parameters.display_saver ? "On" : "off");
+		AT_PRINTF("Send distance = %d m", g_custom_parameters.send_distance);
+		AT_PRINTF("Skip covered cells = %d", g_custom_parameters.skip_covered);
+		AT_PRINTF("Telemetry %s", g_custom_parameters.telemetry ? "binary" : "text");
+		AT_PRINTF("Instant TX hold time = %d ms", g_custom_parameters.instant_tx);
+		if ((g_last_lat != 0) || (g_last_long != 0))
+		{
+			char location_str[32];
+			fmt_location(location_str, "", ",", g_last_lat, g_last_long, 7);
+			AT_PRINTF("Last location = %s", location_str);
+		}
+		else
+		{
+			AT_PRINTF("Last location = NA");
+		}
+		if (g_custom_parameters.pckg_fields[0] != 0)
+		{
+			AT_PRINTF("Packet generator = %s, %d to %d bytes, step %d", g_custom_parameters.pckg_fields,
+					  g_custom_parameters.pckg_min, g_custom_parameters.pckg_max, g_custom_parameters.pckg_step);
+		}
 		atcmd_printf("Custom Packet = ");
 		for (uint8_t i = 0; i < g_custom_parameters.custom_packet_len; i++)
 		{
@@ -395,6 +1047,21 @@ int status_handler(SERIAL_PORT port, char *cmd, stParam *param)
 	return AT_OK;
 }
 
+/**
+ * @brief Get the stored byte of a flag read from flash
+ *     A bool compared with 1 is always false for the compiler,
+ *     the check of the flash content must use the raw byte
+ *
+ * @param flag flag in the settings read from flash
+ * @return uint8_t stored value, 0 or 1 for a valid flag
+ */
+static uint8_t flag_byte(const bool *flag)
+{
+	uint8_t raw;
+	memcpy(&raw, flag, 1);
+	return raw;
+}
+
 /**
  * @brief Get setting from flash
  *
@@ -405,17 +1072,9 @@ bool get_at_setting(void)
 	bool found_problem = false;
 
 	custom_param_s temp_params;
-	uint8_t *flash_value = (uint8_t *)&temp_params.valid_flag;
-	if (!api.system.flash.get(0, flash_value, sizeof(custom_param_s)))
+	if (!settings_load(&temp_params))
 	{
-		MYLOG("AT_CMD", "Failed to read send interval from Flash");
-		return false;
-	}
-	MYLOG("AT_CMD", "Got flag: %02X", temp_params.valid_flag);
-	MYLOG("AT_CMD", "Got send interval: %08X", temp_params.send_interval);
-	if (flash_value[0] != 0xAA)
-	{
-		MYLOG("AT_CMD", "No valid settings found, set to default, read 0X%08X", temp_params.send_interval);
+		MYLOG("AT_CMD", "No valid settings found, set to default");
 		g_custom_parameters.send_interval = 0;
 		g_custom_parameters.test_mode = 0;
 		g_custom_parameters.display_saver = false;
@@ -425,6 +1084,12 @@ bool get_at_setting(void)
 		g_custom_parameters.custom_packet[2] = 0x03;
 		g_custom_parameters.custom_packet[3] = 0x04;
 		g_custom_parameters.custom_packet_len = 4;
+		g_custom_parameters.send_distance = 0;
+		g_custom_parameters.skip_covered = 0;
+		g_custom_parameters.telemetry = false;
+		g_custom_parameters.instant_tx = 0;
+		g_custom_parameters.profile_pending = PROFILE_NONE;
+		g_custom_parameters.pckg_fields[0] = 0;
 		save_at_setting();
 		return false;
 	}
@@ -441,9 +1106,9 @@ bool get_at_setting(void)
 		g_custom_parameters.test_mode = temp_params.test_mode;
 	}
 
-	if (temp_params.display_saver > 1)
+	if (flag_byte(&temp_params.display_saver) > 1)
 	{
-		MYLOG("AT_CMD", "Invalid display mode found %d", temp_params.display_saver);
+		MYLOG("AT_CMD", "Invalid display mode found %d", flag_byte(&temp_params.display_saver));
 		g_custom_parameters.display_saver = false;
 		save_at_setting();
 	}
@@ -452,9 +1117,9 @@ bool get_at_setting(void)
 		g_custom_parameters.display_saver = temp_params.display_saver;
 	}
 
-	if (temp_params.location_on > 1)
+	if (flag_byte(&temp_params.location_on) > 1)
 	{
-		MYLOG("AT_CMD", "Invalid location mode found %d", temp_params.location_on);
+		MYLOG("AT_CMD", "Invalid location mode found %d", flag_byte(&temp_params.location_on));
 		g_custom_parameters.location_on = false;
 		save_at_setting();
 	}
@@ -475,6 +1140,71 @@ bool get_at_setting(void)
 		memcpy(g_custom_parameters.custom_packet, temp_params.custom_packet, g_custom_parameters.custom_packet_len);
 	}
 
+	if (temp_params.send_distance > 10000)
+	{
+		MYLOG("AT_CMD", "Invalid send distance found %d", temp_params.send_distance);
+		g_custom_parameters.send_distance = 0;
+	}
+	else
+	{
+		g_custom_parameters.send_distance = temp_params.send_distance;
+	}
+
+	if (temp_params.skip_covered > 20)
+	{
+		MYLOG("AT_CMD", "Invalid skip covered found %d", temp_params.skip_covered);
+		g_custom_parameters.skip_covered = 0;
+	}
+	else
+	{
+		g_custom_parameters.skip_covered = temp_params.skip_covered;
+	}
+
+	if (flag_byte(&temp_params.telemetry) > 1)
+	{
+		MYLOG("AT_CMD", "Invalid telemetry mode found %d", flag_byte(&temp_params.telemetry));
+		g_custom_parameters.telemetry = false;
+	}
+	else
+	{
+		g_custom_parameters.telemetry = temp_params.telemetry;
+	}
+
+	if ((temp_params.instant_tx != 0) && ((temp_params.instant_tx < 100) || (temp_params.instant_tx > INSTANT_TX_MAX)))
+	{
+		MYLOG("AT_CMD", "Invalid instant TX hold time found %d", temp_params.instant_tx);
+		g_custom_parameters.instant_tx = 0;
+	}
+	else
+	{
+		g_custom_parameters.instant_tx = temp_params.instant_tx;
+	}
+
+	if ((temp_params.profile_pending != PROFILE_NONE) && (temp_params.profile_pending >= PROFILE_MAX))
+	{
+		MYLOG("AT_CMD", "Invalid pending profile found %d", temp_params.profile_pending);
+		g_custom_parameters.profile_pending = PROFILE_NONE;
+	}
+	else
+	{
+		g_custom_parameters.profile_pending = temp_params.profile_pending;
+	}
+
+	temp_params.pckg_fields[PCKG_FIELDS_MAX] = 0;
+	if ((temp_params.pckg_fields[0] != 0) &&
+		!payload_check(temp_params.pckg_fields, temp_params.pckg_min, temp_params.pckg_max, temp_params.pckg_step))
+	{
+		MYLOG("AT_CMD", "Invalid packet generator found %s", temp_params.pckg_fields);
+		g_custom_parameters.pckg_fields[0] = 0;
+	}
+	else
+	{
+		memcpy(g_custom_parameters.pckg_fields, temp_params.pckg_fields, PCKG_FIELDS_MAX + 1);
+		g_custom_parameters.pckg_min = temp_params.pckg_min;
+		g_custom_parameters.pckg_max = temp_params.pckg_max;
+		g_custom_parameters.pckg_step = temp_params.pckg_step;
+	}
+
 	MYLOG("AT_CMD", "Send interval found %ld", g_custom_parameters.send_interval);
 	MYLOG("AT_CMD", "Test mode found %d", g_custom_parameters.test_mode);
 	MYLOG("AT_CMD", "Display mode found %s", g_custom_parameters.display_saver ? "On" : "Off");
@@ -499,16 +1229,22 @@ bool get_at_setting(void)
 bool save_at_setting(void)
 {
 	custom_param_s temp_params;
-	uint8_t *flash_value = (uint8_t *)&temp_params.valid_flag;
 	temp_params.send_interval = g_custom_parameters.send_interval;
 	temp_params.test_mode = g_custom_parameters.test_mode;
 	temp_params.display_saver = g_custom_parameters.display_saver;
 	temp_params.location_on = g_custom_parameters.location_on;
 	memcpy(temp_params.custom_packet, g_custom_parameters.custom_packet, g_custom_parameters.custom_packet_len);
 	temp_params.custom_packet_len = g_custom_parameters.custom_packet_len;
+	temp_params.send_distance = g_custom_parameters.send_distance;
+	temp_params.skip_covered = g_custom_parameters.skip_covered;
+	temp_params.telemetry = g_custom_parameters.telemetry;
+	temp_params.instant_tx = g_custom_parameters.instant_tx;
+	temp_params.profile_pending = g_custom_parameters.profile_pending;
+	memcpy(temp_params.pckg_fields, g_custom_parameters.pckg_fields, PCKG_FIELDS_MAX + 1);
+	temp_params.pckg_min = g_custom_parameters.pckg_min;
+	temp_params.pckg_max = g_custom_parameters.pckg_max;
+	temp_params.pckg_step = g_custom_parameters.pckg_step;
 
-	bool wr_result = false;
-	MYLOG("AT_CMD", "Writing flag: %02X", temp_params.valid_flag);
 	MYLOG("AT_CMD", "Writing send interval 0X%08X ", temp_params.send_interval);
 	MYLOG("AT_CMD", "Writing test mode %d ", temp_params.test_mode);
 	MYLOG("AT_CMD", "Writing display mode %s ", temp_params.display_saver ? "On" : "Off");
@@ -520,12 +1256,13 @@ bool save_at_setting(void)
 	}
 	MYLOG("AT_CMD", "Writing custom packet %s", temp);
 	MYLOG("AT_CMD", "Writing custom packet len %d", temp_params.custom_packet_len);
+	MYLOG("AT_CMD", "Writing send distance %d", temp_params.send_distance);
+	MYLOG("AT_CMD", "Writing skip covered %d", temp_params.skip_covered);
+	MYLOG("AT_CMD", "Writing telemetry mode %s", temp_params.telemetry ? "binary" : "text");
+	MYLOG("AT_CMD", "Writing instant TX hold time %d", temp_params.instant_tx);
+	MYLOG("AT_CMD", "Writing pending profile %d", temp_params.profile_pending);
+	MYLOG("AT_CMD", "Writing packet generator %s %d-%d step %d", temp_params.pckg_fields, temp_params.pckg_min, temp_params.pckg_max, temp_params.pckg_step);
 
-	wr_result = api.system.flash.set(0, flash_value, sizeof(custom_param_s));
-	if (!wr_result)
-	{
-		// Retry
-		wr_result = api.system.flash.set(0, flash_value, sizeof(custom_param_s));
-	}
-	return wr_result;
+	// Only changed settings are written
+	return settings_save(&temp_params);
 }
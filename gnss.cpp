@@ -27,28 +27,70 @@ uint8_t g_gnss_option = 0;
 /** Flag if location was found */
 volatile bool last_read_ok = false;
 
-/** Latitude */
-int64_t latitude = 0;
-/** Longitude */
-int64_t longitude = 0;
-/** Altitude */
+/** Latitude in 1e-7 degrees */
+int32_t latitude = 0;
+/** Longitude in 1e-7 degrees */
+int32_t longitude = 0;
+/** Altitude in mm */
 int32_t altitude = 0;
-/** Accuracy HDOP */
-float accuracy = 0;
+/** Accuracy HDOP in 0.01 */
+uint16_t accuracy = 0;
 /** Number of satellites */
 uint8_t satellites = 0;
 
-/** Last latitude for global use */
-volatile float g_last_lat = 0.0;
-/** Last longitude for global use */
-volatile float g_last_long = 0.0;
-/** Last accuracy for global use */
-volatile float g_last_accuracy = 0.0;
+/** Last latitude for global use in 1e-7 degrees */
+volatile int32_t g_last_lat = 0;
+/** Last longitude for global use in 1e-7 degrees */
+volatile int32_t g_last_long = 0;
+/** Last accuracy (HDOP) for global use in 0.01 */
+volatile uint16_t g_last_accuracy = 0;
 /** Last altitude for global use */
 volatile uint32_t g_last_altitude = 0;
 /** Last number of satellites */
 volatile uint8_t g_last_satellites = 0;
 
+/** Flag if the last acquired location can be reused */
+bool fix_cached = false;
+/** Cached latitude of the last good fix */
+int32_t cached_lat = 0;
+/** Cached longitude of the last good fix */
+int32_t cached_long = 0;
+/** Cached altitude of the last good fix */
+int32_t cached_altitude = 0;
+/** Cached HDOP of the last good fix */
+uint16_t cached_accuracy = 0;
+/** Cached number of satellites of the last good fix */
+uint8_t cached_satellites = 0;
+/** Time of the last good fix in ms */
+uint32_t cached_time = 0;
+/** Flag if the GNSS sleeps while the device is stationary */
+bool gnss_parked = false;
+
+/** Max number of send intervals a cached fix can be reused */
+#define GNSS_REUSE_INTERVALS 5
+/** Max age of a reused fix in ms, used as well if no send interval is set */
+#define GNSS_REUSE_MAX_AGE 1800000
+
+/** Flag if a reference position for the distance trigger is available */
+bool sent_valid = false;
+/** Latitude of the last position sent */
+int32_t sent_lat = 0;
+/** Longitude of the last position sent */
+int32_t sent_long = 0;
+
+/** Cosine of the latitude in 1 degree steps, Q15 fixed point */
+static const int16_t cos_q15[91] = {
+	32767, 32762, 32747, 32722, 32687, 32642, 32587, 32523, 32448, 32364,
+	32269, 32165, 32051, 31927, 31794, 31650, 31498, 31335, 31163, 30982,
+	30791, 30591, 30381, 30162, 29934, 29697, 29451, 29196, 28932, 28659,
+	28377, 28087, 27788, 27481, 27165, 26841, 26509, 26169, 25821, 25465,
+	25101, 24730, 24351, 23964, 23571, 23170, 22762, 22347, 21925, 21497,
+	21062, 20621, 20173, 19720, 19260, 18794, 18323, 17846, 17364, 16876,
+	16384, 15886, 15383, 14876, 14364, 13848, 13328, 12803, 12275, 11743,
+	11207, 10668, 10126, 9580, 9032, 8481, 7927, 7371, 6813, 6252,
+	5690, 5126, 4560, 3993, 3425, 2856, 2286, 1715, 1144, 572,
+	0};
+
 /** Counter for GNSS readings */
 uint16_t check_gnss_counter = 0;
 /** Max number of GNSS readings before giving up */
@@ -59,6 +101,43 @@ uint8_t max_sat = 0;
 /** Number of checks with unchanged number of satellites seen */
 uint8_t max_sat_unchanged = 0;
 
+/** Number of acquisitions kept in the TTFF history */
+#define GNSS_HISTORY_LEN 8
+/** Acquisition limit in polls if no send interval is set (60 seconds) */
+#define GNSS_DEFAULT_MAX_TRY 24
+/** Minimum acquisition budget in polls */
+#define GNSS_MIN_TRY 4
+/** Polls added to the budget if a fix is close when it runs out */
+#define GNSS_EXTEND_TRY 4
+/** Minimum number of recorded acquisitions before the learned budget is used */
+#define GNSS_MIN_HISTORY 3
+
+/** Result of a single location acquisition */
+struct gnss_ttff_s
+{
+	uint16_t ttff;		// Number of polls until the location was accepted
+	uint8_t sat_growth; // Satellites gained after the first 3D fix
+	bool timeout;		// No location found, not part of the TTFF distribution
+};
+
+/** History of the last location acquisitions */
+gnss_ttff_s ttff_history[GNSS_HISTORY_LEN];
+/** Number of valid entries in the TTFF history */
+uint8_t ttff_count = 0;
+/** Next write position in the TTFF history */
+uint8_t ttff_head = 0;
+
+/** Flag if an acquisition is running and has to be recorded */
+bool acq_running = false;
+/** Upper limit of the acquisition, derived from the send interval */
+uint16_t acq_hard_limit = 0;
+/** Poll number of the first 3D fix, 0xFFFF if none yet */
+uint16_t acq_first_fix_poll = 0xFFFF;
+/** Number of satellites at the first 3D fix */
+uint8_t acq_first_fix_sats = 0;
+/** Required number of polls without satellite growth before a fix is accepted */
+uint8_t acq_stable_needed = 2;
+
 /**
  * @brief Initialize the GNSS
  *
@@ -159,6 +238,213 @@ bool init_gnss(bool active)
 	return true;
 }
 
+/**
+ * @brief Put the GNSS to sleep and switch off its supply
+ *     Only Field Tester mode with location on keeps the module powered.
+ *     Unlike init_gnss() this does not configure the receiver and does not wait.
+ *
+ */
+void gnss_power_off(void)
+{
+	gnss_parked = false;
+	if ((g_custom_parameters.test_mode == MODE_FIELDTESTER) && g_custom_parameters.location_on)
+	{
+		return;
+	}
+	if (g_gnss_option != NO_GNSS_INIT)
+	{
+		my_gnss.powerOff(0xFFFFFFFF);
+	}
+	digitalWrite(WB_IO2, LOW);
+	MYLOG("GNSS", "Powered off");
+}
+
+/**
+ * @brief Start a new location acquisition
+ *     The acquisition budget is learned from the last acquisitions.
+ *     It is the 90th percentile of the recorded time-to-fix plus a margin,
+ *     but never longer than half of the send interval. Timeouts are not
+ *     part of the percentile, after a timeout the budget is doubled once.
+ *
+ */
+void gnss_acq_start(void)
+{
+	check_gnss_counter = 0;
+	max_sat = 0;
+	max_sat_unchanged = 0;
+	fix_cached = false;
+	acq_first_fix_poll = 0xFFFF;
+	acq_first_fix_sats = 0;
+	acq_running = true;
+
+	// Max location aquisition time is half of send frequency
+	acq_hard_limit = g_custom_parameters.send_interval / 2 / 2500;
+	if (acq_hard_limit == 0)
+	{
+		acq_hard_limit = GNSS_DEFAULT_MAX_TRY;
+	}
+
+	// Sort a copy of the successful TTFF history (max 8 entries, insertion sort)
+	uint16_t sorted[GNSS_HISTORY_LEN];
+	uint8_t fix_count = 0;
+	uint16_t growth_sum = 0;
+	for (uint8_t idx = 0; idx < ttff_count; idx++)
+	{
+		if (ttff_history[idx].timeout)
+		{
+			continue;
+		}
+		uint16_t value = ttff_history[idx].ttff;
+		int8_t pos = fix_count - 1;
+		while ((pos >= 0) && (sorted[pos] > value))
+		{
+			sorted[pos + 1] = sorted[pos];
+			pos--;
+		}
+		sorted[pos + 1] = value;
+		fix_count++;
+		growth_sum += ttff_history[idx].sat_growth;
+	}
+
+	if (fix_count < GNSS_MIN_HISTORY)
+	{
+		// Not enough history, use the full budget
+		check_gnss_max_try = acq_hard_limit;
+		acq_stable_needed = 2;
+		MYLOG("GNSS", "No TTFF history, budget %d polls", check_gnss_max_try);
+		return;
+	}
+
+	// 90th percentile (nearest rank) of the time-to-fix plus 50% margin
+	uint16_t p90 = sorted[(fix_count * 9 - 1) / 10];
+	uint16_t budget = p90 + p90 / 2 + 2;
+	if (budget < GNSS_MIN_TRY)
+	{
+		budget = GNSS_MIN_TRY;
+	}
+	// The last acquisition timed out, give the next one more time
+	if (ttff_history[(ttff_head + GNSS_HISTORY_LEN - 1) % GNSS_HISTORY_LEN].timeout)
+	{
+		budget *= 2;
+	}
+	if (budget > acq_hard_limit)
+	{
+		budget = acq_hard_limit;
+	}
+	check_gnss_max_try = budget;
+
+	// If the satellite count rarely grows after the first 3D fix, do not wait for it
+	uint16_t growth_avg_x10 = (growth_sum * 10) / fix_count;
+	if (growth_avg_x10 < 10)
+	{
+		acq_stable_needed = 1;
+	}
+	else if (growth_avg_x10 < 30)
+	{
+		acq_stable_needed = 2;
+	}
+	else
+	{
+		acq_stable_needed = 3;
+	}
+	MYLOG("GNSS", "TTFF p90 %d polls, budget %d of %d, stable %d", p90, check_gnss_max_try, acq_hard_limit, acq_stable_needed);
+}
+
+/**
+ * @brief Check if the current fix is good enough to stop the acquisition
+ *     Tracks the growth of the number of satellites
+ *
+ * @param fix_type current fix type
+ * @param sats current number of satellites
+ * @return true 3D fix and satellite count not growing anymore
+ * @return false keep on acquiring
+ */
+bool gnss_acq_satisfied(uint8_t fix_type, uint8_t sats)
+{
+	if (sats > max_sat)
+	{
+		max_sat = sats;
+		max_sat_unchanged = 0;
+	}
+	else
+	{
+		max_sat_unchanged++;
+	}
+
+	if (fix_type < 3)
+	{
+		return false;
+	}
+
+	if (acq_first_fix_poll == 0xFFFF)
+	{
+		acq_first_fix_poll = check_gnss_counter;
+		acq_first_fix_sats = sats;
+	}
+
+	/** Fix type 3D and number of satellites not growing */
+	return max_sat_unchanged >= acq_stable_needed;
+}
+
+/**
+ * @brief Check if the acquisition budget should be extended
+ *     Extends if a fix is close (already a fix or satellites in view)
+ *     but never beyond half of the send interval
+ *
+ * @return true budget was extended
+ * @return false acquisition should stop
+ */
+bool gnss_acq_extend(void)
+{
+	if ((acq_first_fix_poll == 0xFFFF) && (max_sat < 3))
+	{
+		// No fix in sight, odds of a fix are low
+		return false;
+	}
+	if (check_gnss_max_try + GNSS_EXTEND_TRY > acq_hard_limit)
+	{
+		return false;
+	}
+	check_gnss_max_try += GNSS_EXTEND_TRY;
+	MYLOG("GNSS", "Fix is close, extend budget to %d polls", check_gnss_max_try);
+	return true;
+}
+
+/**
+ * @brief Record the result of the acquisition in the TTFF history
+ *     A timeout is recorded, but it is not used for the TTFF percentile
+ *
+ * @param success true if a location was found
+ */
+void gnss_acq_record(bool success)
+{
+	if (!acq_running)
+	{
+		return;
+	}
+	acq_running = false;
+
+	gnss_ttff_s *entry = &ttff_history[ttff_head];
+	if (success)
+	{
+		entry->ttff = check_gnss_counter;
+		entry->sat_growth = (acq_first_fix_poll != 0xFFFF) ? max_sat - acq_first_fix_sats : 0;
+		entry->timeout = false;
+	}
+	else
+	{
+		entry->ttff = check_gnss_counter;
+		entry->sat_growth = 0;
+		entry->timeout = true;
+	}
+	ttff_head = (ttff_head + 1) % GNSS_HISTORY_LEN;
+	if (ttff_count < GNSS_HISTORY_LEN)
+	{
+		ttff_count++;
+	}
+	MYLOG("GNSS", "Recorded TTFF %d polls (%s)", entry->ttff, success ? "fix" : "timeout");
+}
+
 /**
  * @brief Check GNSS module for position
  *
@@ -208,10 +494,12 @@ bool poll_gnss(void)
 		}
 
 		MYLOG("GNSS", "Sat: %d Fix: %s", satellites, fix_type_str);
-		MYLOG("GNSS", "Lat: %.4f Lon: %.4f", latitude / 10000000.0, longitude / 10000000.0);
-		MYLOG("GNSS", "Alt: %.2f", altitude / 1000.0);
-		MYLOG("GNSS", "HDOP: %.2f ", accuracy / 100.0);
+		MYLOG("GNSS", "Lat: %ld Lon: %ld (1e-7 deg)", latitude, longitude);
+		MYLOG("GNSS", "Alt: %ld m", altitude / 1000);
+		MYLOG("GNSS", "HDOP: %d.%02d", accuracy / 100, accuracy % 100);
 
+		// Track the satellite growth for the TTFF history, the quality limits stay
+		gnss_acq_satisfied(fix_type, satellites);
 		if ((accuracy < 300) && (satellites > 5))
 		{
 			last_read_ok = true;
@@ -238,21 +526,8 @@ bool poll_gnss(void)
 
 			satellites = my_gnss.getSIV();
 
-			bool satisfied = false;
-
-			// When in cold start, wait for max satellites
-			if (satellites == max_sat)
-			{
-				max_sat_unchanged++;
-			}
-			if (satellites > max_sat)
-			{
-				max_sat = satellites;
-			}
-			if ((fix_type >= 3) && (max_sat_unchanged >= 2)) /** Fix type 3D and number of satellites not growing */
-			{
-				satisfied = true;
-			}
+			// When in cold start, wait until the number of satellites stops growing
+			bool satisfied = gnss_acq_satisfied(fix_type, satellites);
 
 			if (satisfied)
 			// if ((fix_type >= 3) && (max_sat_unchanged >= 4)) /** Fix type 3D and number of satellites not growing */
@@ -283,12 +558,28 @@ bool poll_gnss(void)
 
 		g_solution_data.addGNSS_T(latitude, longitude, altitude / 1000, accuracy, satellites);
 
-		g_last_lat = latitude / 10000000.0;
-		g_last_long = longitude / 10000000.0;
+		g_last_lat = latitude;
+		g_last_long = longitude;
 		g_last_accuracy = accuracy;
 		g_last_altitude = altitude / 1000;
 		g_last_satellites = satellites;
 
+		gnss_acq_record(true);
+
+		// Keep the location for reuse while the device is not moving
+		cached_lat = latitude;
+		cached_long = longitude;
+		cached_altitude = altitude;
+		cached_accuracy = accuracy;
+		cached_satellites = satellites;
+		cached_time = millis();
+		fix_cached = true;
+
+		// Reference for the distance trigger
+		sent_lat = latitude;
+		sent_long = longitude;
+		sent_valid = true;
+
 		return true;
 	}
 	else
@@ -307,8 +598,8 @@ bool poll_gnss(void)
 
 		last_read_ok = true;
 
-		g_last_lat = latitude / 10000000.0;
-		g_last_long = longitude / 10000000.0;
+		g_last_lat = latitude;
+		g_last_long = longitude;
 		g_last_accuracy = accuracy;
 		g_last_altitude = altitude / 1000;
 		g_last_satellites = satellites;
@@ -328,9 +619,260 @@ bool poll_gnss(void)
 	return false;
 }
 
+/**
+ * @brief Add the cached location of the last good fix to the payload
+ *     The fix is reused for max GNSS_REUSE_INTERVALS send intervals
+ *     and never longer than GNSS_REUSE_MAX_AGE
+ *
+ * @return true cached location was added
+ * @return false no cached location available or too old
+ */
+bool gnss_reuse_fix(void)
+{
+	if (!fix_cached)
+	{
+		return false;
+	}
+	uint32_t max_age = g_custom_parameters.send_interval * GNSS_REUSE_INTERVALS;
+	if ((max_age == 0) || (max_age > GNSS_REUSE_MAX_AGE))
+	{
+		max_age = GNSS_REUSE_MAX_AGE;
+	}
+	if ((millis() - cached_time) > max_age)
+	{
+		MYLOG("GNSS", "Cached location too old");
+		fix_cached = false;
+		return false;
+	}
+	g_solution_data.addGNSS_T(cached_lat, cached_long, cached_altitude / 1000, cached_accuracy, cached_satellites);
+	return true;
+}
+
+/**
+ * @brief Put the GNSS to sleep while the device is stationary
+ *     Location on keeps the module powered, but a reused location needs no receiver.
+ *     gnss_wake() powers it again when the device moves.
+ *
+ */
+void gnss_park(void)
+{
+	my_gnss.powerOff(0xFFFFFFFF);
+	digitalWrite(WB_IO2, LOW);
+	gnss_parked = true;
+	MYLOG("GNSS", "Parked, device is stationary");
+}
+
+/**
+ * @brief Power the GNSS again after gnss_park()
+ *     The receiver configuration was saved by init_gnss() and survives the power cycle
+ *
+ */
+void gnss_wake(void)
+{
+	if (!gnss_parked)
+	{
+		return;
+	}
+	digitalWrite(WB_IO2, HIGH);
+	gnss_parked = false;
+	MYLOG("GNSS", "Woken up, device moved");
+}
+
+/**
+ * @brief Format a fixed point value without float or printf
+ *
+ * @param buf output buffer (max 13 characters + terminator)
+ * @param value fixed point value
+ * @param scale number of implied decimals of the value (max 9)
+ * @param decimals number of decimals to print (max scale), rounded
+ * @return uint8_t number of characters written
+ */
+uint8_t fmt_fixed(char *buf, int32_t value, uint8_t scale, uint8_t decimals)
+{
+	static const uint32_t pow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+	char *pos = buf;
+	uint32_t abs_value = value < 0 ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+
+	// Round to the requested number of decimals
+	uint32_t divider = pow10[scale - decimals];
+	abs_value = (uint32_t)(((uint64_t)abs_value + divider / 2) / divider);
+
+	uint32_t int_part = abs_value / pow10[decimals];
+	uint32_t frac_part = abs_value % pow10[decimals];
+
+	if ((value < 0) && (abs_value != 0))
+	{
+		*pos++ = '-';
+	}
+
+	// Integer part, digits are written in reverse order
+	char digits[10];
+	uint8_t num_digits = 0;
+	do
+	{
+		digits[num_digits++] = '0' + (int_part % 10);
+		int_part /= 10;
+	} while (int_part != 0);
+	while (num_digits != 0)
+	{
+		*pos++ = digits[--num_digits];
+	}
+
+	// Fraction part with leading zeros
+	if (decimals != 0)
+	{
+		*pos++ = '.';
+		for (int8_t idx = decimals - 1; idx >= 0; idx--)
+		{
+			pos[idx] = '0' + (frac_part % 10);
+			frac_part /= 10;
+		}
+		pos += decimals;
+	}
+	*pos = 0x00;
+	return pos - buf;
+}
+
+/**
+ * @brief Format a location as text without float or printf
+ *     Result is <prefix><latitude><separator><longitude>
+ *
+ * @param buf output buffer
+ * @param prefix text before the latitude
+ * @param separator text between latitude and longitude
+ * @param lat latitude in 1e-7 degrees
+ * @param lon longitude in 1e-7 degrees
+ * @param decimals number of decimals to print
+ * @return uint8_t number of characters written
+ */
+uint8_t fmt_location(char *buf, const char *prefix, const char *separator, int32_t lat, int32_t lon, uint8_t decimals)
+{
+	char *pos = buf;
+	while (*prefix)
+	{
+		*pos++ = *prefix++;
+	}
+	pos += fmt_fixed(pos, lat, 7, decimals);
+	while (*separator)
+	{
+		*pos++ = *separator++;
+	}
+	pos += fmt_fixed(pos, lon, 7, decimals);
+	return pos - buf;
+}
+
+/**
+ * @brief Cosine of a latitude, linear interpolation of the table
+ *
+ * @param lat latitude in 1e-7 degrees
+ * @return int32_t cosine in Q15 fixed point
+ */
+int32_t gnss_cos_q15(int32_t lat)
+{
+	if (lat < 0)
+	{
+		lat = -lat;
+	}
+	uint32_t deg = lat / 10000000;
+	if (deg >= 90)
+	{
+		return 0;
+	}
+	int32_t frac = lat % 10000000;
+	return cos_q15[deg] + (int32_t)(((int64_t)(cos_q15[deg + 1] - cos_q15[deg]) * frac) / 10000000);
+}
+
+/**
+ * @brief Distance between two positions (equirectangular approximation)
+ *     Integer only, precise enough for distances up to some kilometers
+ *
+ * @param lat1 latitude of first position in 1e-7 degrees
+ * @param long1 longitude of first position in 1e-7 degrees
+ * @param lat2 latitude of second position in 1e-7 degrees
+ * @param long2 longitude of second position in 1e-7 degrees
+ * @return uint32_t distance in meters
+ */
+uint32_t gnss_distance_m(int32_t lat1, int32_t long1, int32_t lat2, int32_t long2)
+{
+	int64_t d_lat = (int64_t)lat2 - lat1;
+	int64_t d_long = (int64_t)long2 - long1;
+	// Shortest way around the date line
+	if (d_long > 1800000000)
+	{
+		d_long -= 3600000000LL;
+	}
+	else if (d_long < -1800000000)
+	{
+		d_long += 3600000000LL;
+	}
+	int32_t mean_lat = (int32_t)(((int64_t)lat1 + lat2) / 2);
+	d_long = (d_long * gnss_cos_q15(mean_lat)) >> 15;
+
+	// 1e-7 degree is 0.0111319 meter
+	uint64_t dist = int_sqrt((uint64_t)(d_lat * d_lat) + (uint64_t)(d_long * d_long));
+	return (uint32_t)((dist * 111319) / 10000000);
+}
+
+/**
+ * @brief Check if the device moved far enough to send a new test
+ *     Called every 2.5 seconds by the task manager
+ *     Works only in Field Tester mode with location on (GNSS always active)
+ *     While the GNSS is parked it is only powered up again after a motion
+ *
+ */
+void gnss_distance_task(void)
+{
+	if ((g_custom_parameters.test_mode != MODE_FIELDTESTER) || !g_custom_parameters.location_on ||
+		(g_custom_parameters.send_distance == 0) || tx_active || gnss_active || g_settings_ui)
+	{
+		return;
+	}
+	if (gnss_parked)
+	{
+		if (acc_check_moved())
+		{
+			gnss_wake();
+		}
+		return;
+	}
+	if (!api.lorawan.njs.get())
+	{
+		return;
+	}
+
+	if ((my_gnss.getFixType() < 3) || (my_gnss.getSIV() < 4))
+	{
+		return;
+	}
+	int32_t new_lat = my_gnss.getLatitude();
+	int32_t new_long = my_gnss.getLongitude();
+
+	if (!sent_valid)
+	{
+		// First position is the reference
+		sent_lat = new_lat;
+		sent_long = new_long;
+		sent_valid = true;
+		return;
+	}
+
+	uint32_t distance = gnss_distance_m(sent_lat, sent_long, new_lat, new_long);
+	if (distance >= g_custom_parameters.send_distance)
+	{
+		MYLOG("GNSS", "Moved %ld m, send test", distance);
+		// New reference, if the test ends without an accepted fix the next
+		// test is sent after moving the distance again, not on the next check
+		sent_lat = new_lat;
+		sent_long = new_long;
+		send_packet(NULL);
+		// Periodic sending continues from this test
+		start_send_timer();
+	}
+}
+
 /**
  * @brief GNSS location aqcuisition
- * Called every 2.5 seconds by timer 1
+ * Called from timer_task every 2.5 seconds, triggered by timer 3
  * Gives up after 1/2 of send frequency
  * or when location was aquired
  *
@@ -355,26 +897,38 @@ void gnss_handler(void *)
 		{
 			oled_clear();
 			oled_add_line((char *)"Location:");
-			sprintf(line_str, "La %.4f Lo %.4f", g_last_lat, g_last_long, g_last_altitude);
+			fmt_location(line_str, "La ", " Lo ", g_last_lat, g_last_long, 4);
 			oled_add_line(line_str);
-			sprintf(line_str, "HDOP %.2f Sat: %d", g_last_accuracy, g_last_satellites );
+			sprintf(line_str, "HDOP %d.%02d Sat: %d", g_last_accuracy / 100, g_last_accuracy % 100, g_last_satellites);
 			oled_add_line(line_str);
 		}
 		finished_poll = true;
-		// Always send confirmed packet to make sure a reply is received
-		if (!api.lorawan.send(g_solution_data.getSize(), g_solution_data.getBuffer(), 1, true, 7))
+		if (!forced_tx && coverage_skip(g_last_lat, g_last_long))
 		{
+			if (has_oled && !g_settings_ui)
+			{
+				oled_add_line((char *)"Cell covered, skip test");
+			}
 			tx_active = false;
-			MYLOG("APP", "LoRaWAN send returned error");
 		}
 		else
 		{
-			tx_active = true;
+			forced_tx = false;
+			// Always send confirmed packet to make sure a reply is received
+			if (!api.lorawan.send(g_solution_data.getSize(), g_solution_data.getBuffer(), 1, true, 7))
+			{
+				tx_active = false;
+				MYLOG("APP", "LoRaWAN send returned error");
+			}
+			else
+			{
+				tx_active = true;
+			}
 		}
 	}
 	else
 	{
-		if (check_gnss_counter >= check_gnss_max_try)
+		if ((check_gnss_counter >= check_gnss_max_try) && !gnss_acq_extend())
 		{
 			// Keep GNSS active until we get a valid location!
 			delay(100);
@@ -383,6 +937,7 @@ void gnss_handler(void *)
 
 			MYLOG("GNSS", "Location timeout");
 			api.system.timer.stop(RAK_TIMER_3);
+			gnss_acq_record(false);
 			// If no location found, Field Tester does not send data
 			if (has_oled && !g_settings_ui)
 			{
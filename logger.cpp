@@ -0,0 +1,272 @@
+/**
+ * @file logger.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Result log in a flash ring buffer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Number of records in one flash page, records never cross a page boundary */
+#define LOG_PAGE_RECORDS (APP_FLASH_PAGE_SIZE / sizeof(log_record_s))
+/** Number of records in the log */
+#define LOG_RECORDS (LOG_PAGE_RECORDS * LOG_FLASH_PAGES)
+/** Number of records collected in RAM before they are written to flash */
+#define LOG_STAGE_SIZE 8
+
+/** RAM image of the flash page that is written next, new records are staged in it */
+log_record_s log_page[LOG_PAGE_RECORDS];
+/** Number of staged records in the page image */
+uint8_t log_staged = 0;
+/** Next free slot in the flash ring buffer */
+uint16_t log_next_slot = 0;
+/** Flag if the user flash covers the log area */
+bool log_available = false;
+/** Sequence number of the next record */
+uint32_t log_next_seq = 0;
+/** Number of records in flash */
+uint16_t g_log_count = 0;
+
+/**
+ * @brief Calculate CRC16 (CCITT, polynom 0x1021, start 0xFFFF)
+ *
+ * @param data data buffer
+ * @param len length of the data
+ * @return uint16_t CRC of the data
+ */
+uint16_t crc16(const uint8_t *data, uint16_t len)
+{
+	uint16_t crc = 0xFFFF;
+	for (uint16_t idx = 0; idx < len; idx++)
+	{
+		crc ^= (uint16_t)data[idx] << 8;
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+/**
+ * @brief Get the flash offset of a log slot
+ *
+ * @param slot slot number
+ * @return uint32_t flash offset
+ */
+static uint32_t log_slot_offset(uint16_t slot)
+{
+	return LOG_FLASH_START + (slot / LOG_PAGE_RECORDS) * APP_FLASH_PAGE_SIZE + (slot % LOG_PAGE_RECORDS) * sizeof(log_record_s);
+}
+
+/**
+ * @brief Check if a record read from flash is valid
+ *
+ * @param record pointer to the record
+ * @return true if the record is used and the CRC matches
+ */
+static bool log_record_valid(log_record_s *record)
+{
+	return (record->seq != 0xFFFFFFFF) && (record->crc == crc16((uint8_t *)record, offsetof(log_record_s, crc)));
+}
+
+/**
+ * @brief Load the page image for the next free slot
+ *     A page that is entered starts empty, the old records in flash
+ *     are overwritten with the first write of the page
+ *
+ */
+static void log_load_page(void)
+{
+	if ((log_next_slot % LOG_PAGE_RECORDS) == 0)
+	{
+		memset(log_page, 0xFF, sizeof(log_page));
+	}
+	else
+	{
+		api.system.flash.get(log_slot_offset(log_next_slot - (log_next_slot % LOG_PAGE_RECORDS)), (uint8_t *)log_page, sizeof(log_page));
+	}
+}
+
+/**
+ * @brief Find the end of the log in flash
+ *     The record with the highest sequence number is the newest one.
+ *     The log is disabled if the RUI3 user flash does not cover the log area.
+ *
+ */
+void init_log(void)
+{
+	uint32_t newest_seq = 0;
+	bool found = false;
+	g_log_count = 0;
+	log_staged = 0;
+
+	// Read the flash page by page, the last read checks the end of the log area
+	log_available = true;
+	for (uint16_t page = 0; page < LOG_FLASH_PAGES; page++)
+	{
+		uint16_t slot = page * LOG_PAGE_RECORDS;
+		if (!api.system.flash.get(log_slot_offset(slot), (uint8_t *)log_page, sizeof(log_page)))
+		{
+			MYLOG("LOG", "User flash does not cover the log area, log disabled");
+			log_available = false;
+			g_log_count = 0;
+			return;
+		}
+		for (uint16_t idx = 0; idx < LOG_PAGE_RECORDS; idx++)
+		{
+			if (!log_record_valid(&log_page[idx]))
+			{
+				continue;
+			}
+			g_log_count++;
+			if (!found || (log_page[idx].seq > newest_seq))
+			{
+				found = true;
+				newest_seq = log_page[idx].seq;
+				log_next_slot = (slot + idx + 1) % LOG_RECORDS;
+			}
+		}
+	}
+	log_next_seq = found ? newest_seq + 1 : 0;
+	log_load_page();
+	MYLOG("LOG", "%d records, next slot %d, next seq %ld", g_log_count, log_next_slot, log_next_seq);
+}
+
+/**
+ * @brief Write the staged records to flash
+ *     The page image is written with a single flash.set, which costs one page
+ *     erase in RUI3. The records are staged, so the pages wear evenly.
+ *     If the write fails the records stay staged for the next try.
+ *
+ */
+void log_flush(void)
+{
+	if (!log_available || (log_staged == 0))
+	{
+		return;
+	}
+	uint16_t page_start = log_next_slot - (log_next_slot % LOG_PAGE_RECORDS);
+	if (!api.system.flash.set(log_slot_offset(page_start), (uint8_t *)log_page, sizeof(log_page)))
+	{
+		MYLOG("LOG", "Flash write failed");
+		return;
+	}
+	// The first write of a page replaced the oldest records
+	if ((log_next_slot == page_start) && (g_log_count > (LOG_RECORDS - LOG_PAGE_RECORDS)))
+	{
+		g_log_count = LOG_RECORDS - LOG_PAGE_RECORDS;
+	}
+	log_next_slot = (log_next_slot + log_staged) % LOG_RECORDS;
+	g_log_count += log_staged;
+	log_staged = 0;
+	log_load_page();
+}
+
+/**
+ * @brief Add a test result to the log
+ *     The position is the last known location.
+ *     If binary telemetry is enabled the result is sent on the Serial port as well
+ *
+ * @param event event type, same as the display reason
+ * @param rssi RSSI (for Field Tester the best gateway RSSI)
+ * @param snr SNR
+ * @param margin demodulation margin (LinkCheck only)
+ * @param gateways number of gateways
+ */
+void log_result(uint8_t event, int16_t rssi, int8_t snr, int8_t margin, uint8_t gateways)
+{
+	log_record_s new_record;
+	log_record_s *record = &new_record;
+	record->seq = log_next_seq++;
+	record->time = millis() / 1000;
+	record->lat = g_last_lat;
+	record->lon = g_last_long;
+	record->rssi = rssi;
+	record->snr = snr;
+	record->margin = margin;
+	record->mode = g_custom_parameters.test_mode;
+	record->gateways = gateways;
+	record->crc = crc16((uint8_t *)record, offsetof(log_record_s, crc));
+
+	if (g_custom_parameters.telemetry)
+	{
+		telemetry_send(event, record);
+	}
+
+	if (!log_available)
+	{
+		return;
+	}
+	// Staged records never cross the page end, a failed write keeps them staged
+	uint16_t page_slot = (log_next_slot % LOG_PAGE_RECORDS) + log_staged;
+	if (page_slot == LOG_PAGE_RECORDS)
+	{
+		MYLOG("LOG", "Page image full, record dropped");
+		return;
+	}
+	log_page[page_slot] = new_record;
+	log_staged++;
+	if ((log_staged >= LOG_STAGE_SIZE) || (page_slot == (LOG_PAGE_RECORDS - 1)))
+	{
+		log_flush();
+	}
+}
+
+/**
+ * @brief Background task, writes records that wait too long in the staging buffer
+ *
+ */
+void log_task(void)
+{
+	if ((log_staged != 0) && !tx_active)
+	{
+		log_flush();
+	}
+}
+
+/**
+ * @brief Read a record from the log
+ *
+ * @param index record number, 0 is the oldest record
+ * @param record buffer for the record
+ * @return true if the record is valid
+ * @return false if the index is invalid or the record is corrupted
+ */
+bool log_read(uint16_t index, log_record_s *record)
+{
+	if (index >= g_log_count)
+	{
+		return false;
+	}
+	uint16_t slot = (log_next_slot + LOG_RECORDS - g_log_count + index) % LOG_RECORDS;
+	api.system.flash.get(log_slot_offset(slot), (uint8_t *)record, sizeof(log_record_s));
+	return log_record_valid(record);
+}
+
+/**
+ * @brief Erase the complete log
+ *
+ */
+void log_erase(void)
+{
+	log_next_slot = 0;
+	log_next_seq = 0;
+	log_staged = 0;
+	g_log_count = 0;
+	if (!log_available)
+	{
+		return;
+	}
+	memset(log_page, 0xFF, sizeof(log_page));
+	for (uint16_t page = 0; page < LOG_FLASH_PAGES; page++)
+	{
+		if (!api.system.flash.set(log_slot_offset(page * LOG_PAGE_RECORDS), (uint8_t *)log_page, sizeof(log_page)))
+		{
+			MYLOG("LOG", "Flash erase failed");
+		}
+	}
+}
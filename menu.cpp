@@ -0,0 +1,664 @@
+/**
+ * @file menu.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Table driven settings UI
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Styles of value screens */
+enum menu_style_e
+{
+	STYLE_LIST = 0, // Previous, current and next value in lines 2 to 4
+	STYLE_STEP,		// Current value in line 4
+	STYLE_TOGGLE	// Current value in line 1, changed with 2 clicks
+};
+
+/** Description of a menu with selectable items */
+struct menu_list_s
+{
+	uint8_t menu;								  // Menu ID
+	uint8_t parent;								  // Menu opened with a single click, S_SUB_NONE = exit UI
+	const char *const *items;					  // Menu items
+	uint8_t items_len;							  // Number of menu items
+	uint8_t target[5];							  // Menu opened with 2 to 6 clicks, S_SUB_NONE = action
+	uint8_t (*action)(uint8_t clicks);			  // Optional action, returns the menu to open or S_SUB_NONE
+	void (*format)(char *text, uint8_t idx);	  // Optional item formatter
+	void (*draw)(void);							  // Optional custom screen
+};
+
+/** Description of a value screen */
+struct menu_value_s
+{
+	uint8_t menu;								  // Menu ID
+	uint8_t parent;								  // Menu opened with a single click
+	uint8_t style;								  // Screen style
+	void *value;								  // Value buffer
+	uint8_t size;								  // Size of the value buffer, 1 or 4 bytes
+	int32_t min;								  // Lowest value
+	int32_t max;								  // Highest value
+	int32_t step;								  // Change per click
+	bool wrap;									  // Wrap around at the limits
+	uint8_t x_pos;								  // Column of the value
+	const char *up_label;						  // Label of the 2 clicks action
+	const char *down_label;						  // Label of the 3 clicks action
+	void (*range)(int32_t *low, int32_t *high);	  // Optional range depending on the region
+	void (*format)(char *text, int32_t value);	  // Value formatter
+};
+
+/** Current selected menu */
+uint8_t sel_menu = T_TOP_MENU;
+
+/** Content of top level menu */
+const char *const top_menu[] = {"Back", "Info", "Device Settings", "Mode", "LoRa Setting", "Profiles"};
+/** Content of device settings menu */
+const char *const settings_menu[] = {"Back", "Interval", "Location", "Display Saver"};
+/** Content of test mode menu */
+const char *const mode_menu[] = {"Back", "LPW LinkCheck", "P2P", "Field Tester"};
+/** Content of P2P settings menu */
+const char *const settings_p2p_menu[] = {"Back", "Freq", "SF", "BW", "CR", "TX"};
+/** Content of LoRaWAN settings menu */
+const char *const settings_lpw_menu[] = {"Back", "ADR", "DR", "TX", "Region"};
+/** Content of profile menu, the names are read from flash */
+const char *const profile_menu[] = {"Back", "P1", "P2", "P3", "P4"};
+
+/**
+ * @brief Top menu actions, 5 clicks opens the LoRaWAN or P2P settings
+ *
+ * @param clicks number of clicks
+ * @return uint8_t menu to open
+ */
+static uint8_t top_action(uint8_t clicks)
+{
+	return api.lorawan.nwm.get() == 1 ? T_LORAWAN_MENU : T_LORAP2P_MENU;
+}
+
+/**
+ * @brief Device settings actions, toggle location (3 clicks) or display saver (4 clicks)
+ *     Changes are not saved before the UI is closed
+ *
+ * @param clicks number of clicks
+ * @return uint8_t S_SUB_NONE, the menu stays open
+ */
+static uint8_t settings_action(uint8_t clicks)
+{
+	if (clicks == 3)
+	{
+		g_last_settings.location_on = !g_last_settings.location_on;
+	}
+	else if (clicks == 4)
+	{
+		g_last_settings.display_saver = !g_last_settings.display_saver;
+	}
+	return S_SUB_NONE;
+}
+
+/**
+ * @brief Device settings items with on/off status
+ *
+ * @param text buffer for the item text
+ * @param idx item index
+ */
+static void settings_format(char *text, uint8_t idx)
+{
+	if (idx == 2)
+	{
+		sprintf(text, "(%d) %s %s", idx + 1, settings_menu[idx], g_last_settings.location_on ? "on" : "off");
+	}
+	else if (idx == 3)
+	{
+		sprintf(text, "(%d) %s %s", idx + 1, settings_menu[idx], g_last_settings.display_saver ? "on" : "off");
+	}
+	else
+	{
+		sprintf(text, "(%d) %s", idx + 1, settings_menu[idx]);
+	}
+}
+
+/**
+ * @brief Test mode selection, 2 = LinkCheck, 3 = P2P, 4 = Field Tester
+ *
+ * @param clicks number of clicks
+ * @return uint8_t S_SUB_NONE, the menu stays open
+ */
+static uint8_t mode_action(uint8_t clicks)
+{
+	if ((clicks >= 2) && (clicks <= 4))
+	{
+		g_last_settings.test_mode = clicks - 2;
+	}
+	return S_SUB_NONE;
+}
+
+/**
+ * @brief Test mode items, the selected mode is marked with (X)
+ *
+ * @param text buffer for the item text
+ * @param idx item index
+ */
+static void mode_format(char *text, uint8_t idx)
+{
+	if (idx == g_last_settings.test_mode + 1)
+	{
+		sprintf(text, "(X) %s", mode_menu[idx]);
+	}
+	else
+	{
+		sprintf(text, "(%d) %s", idx + 1, mode_menu[idx]);
+	}
+}
+
+/**
+ * @brief Apply a profile (2 to 5 clicks) and close the UI
+ *     Changes done in the UI are dropped, the profile replaces them
+ *
+ * @param clicks number of clicks
+ * @return uint8_t S_SUB_NONE, the menu stays open if the slot is empty
+ */
+static uint8_t profile_action(uint8_t clicks)
+{
+	profile_s profile;
+	uint8_t slot = clicks - 2;
+	if (!profile_get(slot, &profile))
+	{
+		return S_SUB_NONE;
+	}
+
+	g_settings_ui = false;
+	oled_clear();
+	bool restart = false;
+	if (!profile_apply(slot, &restart))
+	{
+		// Uplink in progress, the profile would change the test mode
+		oled_add_line((char *)"TX active, profile");
+		oled_add_line((char *)"not applied");
+		start_send_timer();
+	}
+	else if (restart)
+	{
+		oled_write_header((char *)"REBOOT");
+		sprintf(line_str, "Profile %s", profile.name);
+		oled_add_line(line_str);
+		oled_flush();
+		restart_test_mode();
+	}
+	else
+	{
+		sprintf(line_str, "Profile %s", profile.name);
+		oled_add_line(line_str);
+		sprintf(line_str, "Test interval %lds", g_custom_parameters.send_interval / 1000);
+		oled_add_line(line_str);
+	}
+
+	if (g_custom_parameters.display_saver)
+	{
+		api.system.timer.start(RAK_TIMER_2, 60000, NULL);
+	}
+	return S_SUB_NONE;
+}
+
+/**
+ * @brief Profile items with the profile names
+ *
+ * @param text buffer for the item text
+ * @param idx item index
+ */
+static void profile_format(char *text, uint8_t idx)
+{
+	profile_s profile;
+	if ((idx != 0) && profile_get(idx - 1, &profile))
+	{
+		sprintf(text, "(%d) %s", idx + 1, profile.name);
+	}
+	else if (idx != 0)
+	{
+		sprintf(text, "(%d) %s empty", idx + 1, profile_menu[idx]);
+	}
+	else
+	{
+		sprintf(text, "(%d) %s", idx + 1, profile_menu[idx]);
+	}
+}
+
+/**
+ * @brief Draw the info screen
+ *
+ */
+static void info_draw(void)
+{
+	oled_write_line(0, 0, (char *)"(1) Back");
+	switch (g_last_settings.test_mode)
+	{
+	case MODE_LINKCHECK:
+		oled_write_line(1, 0, (char *)"LinkCheck Mode");
+		break;
+	case MODE_P2P:
+		oled_write_line(1, 0, (char *)"P2P Mode");
+		break;
+	case MODE_FIELDTESTER:
+		oled_write_line(1, 0, (char *)"Field Tester mode");
+		break;
+	}
+	sprintf(line_str, "Sent interval %lds", g_last_settings.send_interval / 1000);
+	oled_write_line(2, 0, line_str);
+	sprintf(line_str, "Location %s", g_last_settings.location_on ? "on" : "off");
+	oled_write_line(3, 0, line_str);
+	sprintf(line_str, "Display saver %s", g_last_settings.display_saver ? "on" : "off");
+	oled_write_line(4, 0, line_str);
+}
+
+/** Menus with selectable items */
+const menu_list_s menu_lists[] = {
+	{T_TOP_MENU, S_SUB_NONE, top_menu, 6, {T_INFO_MENU, T_SETT_MENU, T_MODE_MENU, S_SUB_NONE, T_PROF_MENU}, top_action, NULL, NULL},
+	{T_INFO_MENU, T_TOP_MENU, NULL, 0, {T_TOP_MENU, T_TOP_MENU, T_TOP_MENU, S_SUB_NONE, S_SUB_NONE}, NULL, NULL, info_draw},
+	{T_SETT_MENU, T_TOP_MENU, settings_menu, 4, {S_SEND_INT, S_SUB_NONE, S_SUB_NONE, S_SUB_NONE, S_SUB_NONE}, settings_action, settings_format, NULL},
+	{T_MODE_MENU, T_TOP_MENU, mode_menu, 4, {S_SUB_NONE, S_SUB_NONE, S_SUB_NONE, S_SUB_NONE, S_SUB_NONE}, mode_action, mode_format, NULL},
+	{T_LORAWAN_MENU, T_TOP_MENU, settings_lpw_menu, 5, {S_LPW_ADR, S_LPW_DR, S_LPW_TX, S_LPW_BAND, S_SUB_NONE}, NULL, NULL, NULL},
+	{T_LORAP2P_MENU, T_TOP_MENU, settings_p2p_menu, 6, {S_P2P_FREQ, S_P2P_SF, S_P2P_BW, S_P2P_CR, S_P2P_TX}, NULL, NULL, NULL},
+	{T_PROF_MENU, T_TOP_MENU, profile_menu, 5, {S_SUB_NONE, S_SUB_NONE, S_SUB_NONE, S_SUB_NONE, S_SUB_NONE}, profile_action, profile_format, NULL},
+};
+
+/**
+ * @brief DR range of the current LoRaWAN region
+ *
+ * @param low returns lowest DR
+ * @param high returns highest DR
+ */
+static void dr_range(int32_t *low, int32_t *high)
+{
+	switch (api.lorawan.band.get())
+	{
+	case 5: // US915
+		*low = 0;
+		*high = 4;
+		break;
+	case 6:	 // AU915
+	case 12: // LA915
+		*low = 0;
+		*high = 6;
+		break;
+	case 8:	 // AS923-1
+	case 9:	 // AS923-2
+	case 10: // AS923-3
+	case 11: // AS923-4
+		*low = 2;
+		*high = 5;
+		break;
+	default: // EU433, CN470, RU864, IN865, EU868, KR920
+		*low = 0;
+		*high = 5;
+		break;
+	}
+}
+
+/**
+ * @brief TX power range of the current LoRaWAN region
+ *
+ * @param low returns lowest TX power index
+ * @param high returns highest TX power index
+ */
+static void tx_range(int32_t *low, int32_t *high)
+{
+	*low = 0;
+	switch (api.lorawan.band.get())
+	{
+	case 0: // EU433
+		*high = 5;
+		break;
+	case 3:	 // IN865
+	case 5:	 // US915
+	case 6:	 // AU915
+	case 12: // LA915
+		*high = 10;
+		break;
+	default: // CN470, RU864, EU868, KR920, AS923-1 to AS923-4
+		*high = 7;
+		break;
+	}
+}
+
+/**
+ * @brief Value formatters
+ *
+ * @param text buffer for the value text
+ * @param value value to format
+ */
+static void interval_format(char *text, int32_t value)
+{
+	sprintf(text, "              ==>  %ld s", value / 1000);
+}
+static void band_format(char *text, int32_t value)
+{
+	sprintf(text, "%s", g_regions_list[value]);
+}
+static void adr_format(char *text, int32_t value)
+{
+	sprintf(text, "(2) ADR %s", value == 0 ? "OFF" : "ON");
+}
+static void dr_format(char *text, int32_t value)
+{
+	sprintf(text, "DR%ld", value);
+}
+static void txp_format(char *text, int32_t value)
+{
+	sprintf(text, "TXP %ld", value);
+}
+static void freq_format(char *text, int32_t value)
+{
+	sprintf(text, "              ==>  %.3f MHz", value / 1000000.0);
+}
+static void sf_format(char *text, int32_t value)
+{
+	sprintf(text, "SF %ld", value);
+}
+static void bw_format(char *text, int32_t value)
+{
+	sprintf(text, "BW %skHz", p_bw_menu[value]);
+}
+static void cr_format(char *text, int32_t value)
+{
+	sprintf(text, "CR 4/%ld", value + 5);
+}
+
+/** Value screens */
+const menu_value_s menu_values[] = {
+	{S_SEND_INT, T_SETT_MENU, STYLE_STEP, &g_last_settings.send_interval, 4, 0, 0x7FFFFFFF, 10000, false, 0, "(2) 10 seconds more", "(3) 10 seconds less", NULL, interval_format},
+	{S_LPW_BAND, T_LORAWAN_MENU, STYLE_LIST, &ui_last_band, 1, 0, 12, 1, true, 64, "(2) Next", "(3) Prev", NULL, band_format},
+	{S_LPW_ADR, T_LORAWAN_MENU, STYLE_TOGGLE, &ui_last_adr, 1, 0, 1, 1, true, 0, NULL, NULL, NULL, adr_format},
+	{S_LPW_DR, T_LORAWAN_MENU, STYLE_LIST, &ui_last_dr, 1, 0, 15, 1, true, 64, "(2) Next", "(3) Prev", dr_range, dr_format},
+	{S_LPW_TX, T_LORAWAN_MENU, STYLE_LIST, &ui_last_tx, 1, 0, 10, 1, true, 64, "(2) Next", "(3) Prev", tx_range, txp_format},
+	{S_P2P_FREQ, T_LORAP2P_MENU, STYLE_STEP, &ui_p2p_freq, 4, 430000000, 960000000, 100000, false, 0, "(2) 0.1MHz up", "(3) 0.1MHz down", NULL, freq_format},
+	{S_P2P_SF, T_LORAP2P_MENU, STYLE_LIST, &ui_p2p_sf, 1, 6, 12, 1, true, 64, "(2) Next", "(3) Prev", NULL, sf_format},
+	{S_P2P_BW, T_LORAP2P_MENU, STYLE_LIST, &ui_p2p_bw, 1, 0, 9, 1, true, 44, "(2) Next", "(3) Prev", NULL, bw_format},
+	{S_P2P_CR, T_LORAP2P_MENU, STYLE_LIST, &ui_p2p_cr, 1, 0, 3, 1, true, 64, "(2) Next", "(3) Prev", NULL, cr_format},
+	{S_P2P_TX, T_LORAP2P_MENU, STYLE_LIST, &ui_p2p_tx, 1, 5, 22, 1, true, 64, "(2) Next", "(3) Prev", NULL, txp_format},
+};
+
+/**
+ * @brief Find a menu with selectable items
+ *
+ * @param menu menu ID
+ * @return const menu_list_s* menu description or NULL
+ */
+static const menu_list_s *find_list(uint8_t menu)
+{
+	for (uint8_t idx = 0; idx < sizeof(menu_lists) / sizeof(menu_list_s); idx++)
+	{
+		if (menu_lists[idx].menu == menu)
+		{
+			return &menu_lists[idx];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Find a value screen
+ *
+ * @param menu menu ID
+ * @return const menu_value_s* value screen description or NULL
+ */
+static const menu_value_s *find_value(uint8_t menu)
+{
+	for (uint8_t idx = 0; idx < sizeof(menu_values) / sizeof(menu_value_s); idx++)
+	{
+		if (menu_values[idx].menu == menu)
+		{
+			return &menu_values[idx];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Read the value of a value screen
+ *
+ * @param entry value screen description
+ * @return int32_t value
+ */
+static int32_t get_value(const menu_value_s *entry)
+{
+	return entry->size == 1 ? *(uint8_t *)entry->value : *(int32_t *)entry->value;
+}
+
+/**
+ * @brief Write the value of a value screen
+ *
+ * @param entry value screen description
+ * @param value new value
+ */
+static void set_value(const menu_value_s *entry, int32_t value)
+{
+	if (entry->size == 1)
+	{
+		*(uint8_t *)entry->value = value;
+	}
+	else
+	{
+		*(int32_t *)entry->value = value;
+	}
+}
+
+/**
+ * @brief Get the range of a value screen
+ *
+ * @param entry value screen description
+ * @param low returns the lowest value
+ * @param high returns the highest value
+ */
+static void get_range(const menu_value_s *entry, int32_t *low, int32_t *high)
+{
+	*low = entry->min;
+	*high = entry->max;
+	if (entry->range != NULL)
+	{
+		entry->range(low, high);
+	}
+}
+
+/**
+ * @brief Get the value one step up or down
+ *
+ * @param entry value screen description
+ * @param value current value
+ * @param up true for a step up, false for a step down
+ * @return int32_t new value
+ */
+static int32_t step_value(const menu_value_s *entry, int32_t value, bool up)
+{
+	int32_t low;
+	int32_t high;
+	get_range(entry, &low, &high);
+	if (up)
+	{
+		if (value >= high)
+		{
+			return entry->wrap ? low : high;
+		}
+		return (high - value) < entry->step ? high : value + entry->step;
+	}
+	if (value <= low)
+	{
+		return entry->wrap ? high : low;
+	}
+	return (value - low) < entry->step ? low : value - entry->step;
+}
+
+/**
+ * @brief Draw the value lines of a value screen
+ *     Only the value area is cleared, the labels stay
+ *
+ * @param entry value screen description
+ */
+static void draw_value(const menu_value_s *entry)
+{
+	int32_t value = get_value(entry);
+	char text[32];
+	switch (entry->style)
+	{
+	case STYLE_LIST:
+		oled_clear_line(2, entry->x_pos, 3);
+		entry->format(text, step_value(entry, value, false));
+		oled_write_line(2, entry->x_pos, text);
+		entry->format(text, value);
+		sprintf(line_str, "==>  %s", text);
+		oled_write_line(3, entry->x_pos, line_str);
+		entry->format(text, step_value(entry, value, true));
+		oled_write_line(4, entry->x_pos, text);
+		break;
+	case STYLE_STEP:
+		oled_clear_line(4, entry->x_pos, 1);
+		entry->format(line_str, value);
+		oled_write_line(4, entry->x_pos, line_str);
+		break;
+	case STYLE_TOGGLE:
+		// Clearing line 1 cuts the descenders of line 0, write it again
+		oled_clear_line(1, entry->x_pos, 1);
+		oled_write_line(0, 0, (char *)"(1) Back");
+		entry->format(line_str, value);
+		oled_write_line(1, entry->x_pos, line_str);
+		break;
+	}
+}
+
+/**
+ * @brief Draw the items of a menu, more than 5 items use a second column
+ *
+ * @param entry menu description
+ */
+static void draw_items(const menu_list_s *entry)
+{
+	for (uint8_t idx = 0; idx < entry->items_len; idx++)
+	{
+		if (entry->format != NULL)
+		{
+			entry->format(line_str, idx);
+		}
+		else
+		{
+			sprintf(line_str, "(%d) %s", idx + 1, entry->items[idx]);
+		}
+		if (idx > 4)
+		{
+			oled_write_line(idx - 5, 64, line_str);
+		}
+		else
+		{
+			oled_write_line(idx, 0, line_str);
+		}
+	}
+}
+
+/**
+ * @brief Open a menu and draw the complete screen
+ *
+ * @param menu menu ID
+ */
+void menu_show(uint8_t menu)
+{
+	sel_menu = menu;
+	oled_clear();
+
+	const menu_list_s *list = find_list(menu);
+	if (list != NULL)
+	{
+		if (list->draw != NULL)
+		{
+			list->draw();
+		}
+		else
+		{
+			draw_items(list);
+		}
+		oled_flush();
+		return;
+	}
+
+	const menu_value_s *entry = find_value(menu);
+	if (entry != NULL)
+	{
+		oled_write_line(0, 0, (char *)"(1) Back");
+		if (entry->up_label != NULL)
+		{
+			oled_write_line(1, 0, (char *)entry->up_label);
+		}
+		if (entry->down_label != NULL)
+		{
+			oled_write_line(2, 0, (char *)entry->down_label);
+		}
+		// Make sure the value is in the range of the current region
+		int32_t low;
+		int32_t high;
+		get_range(entry, &low, &high);
+		int32_t value = get_value(entry);
+		if ((value < low) || (value > high))
+		{
+			set_value(entry, value < low ? low : high);
+		}
+		draw_value(entry);
+	}
+	oled_flush();
+}
+
+/**
+ * @brief Handle clicks while the settings UI is active
+ *     A single click goes one level up, 2 to 6 clicks select an item or change a value
+ *
+ * @param clicks number of clicks
+ */
+void menu_click(uint8_t clicks)
+{
+	const menu_list_s *list = find_list(sel_menu);
+	const menu_value_s *entry = find_value(sel_menu);
+	uint8_t parent = (list != NULL) ? list->parent : ((entry != NULL) ? entry->parent : T_TOP_MENU);
+
+	if (clicks == 1)
+	{
+		if (parent == S_SUB_NONE)
+		{
+			// Exit menu
+			g_settings_ui = false;
+			save_n_reboot();
+		}
+		else
+		{
+			menu_show(parent);
+		}
+	}
+	else if ((list != NULL) && ((list->draw != NULL) || (clicks <= list->items_len)))
+	{
+		uint8_t target = list->target[clicks - 2];
+		if ((target == S_SUB_NONE) && (list->action != NULL))
+		{
+			target = list->action(clicks);
+			if (!g_settings_ui)
+			{
+				// The action closed the UI
+				target = S_SUB_NONE;
+			}
+			else if (target == S_SUB_NONE)
+			{
+				// Item status changed, redraw the menu
+				target = sel_menu;
+			}
+		}
+		if (target != S_SUB_NONE)
+		{
+			menu_show(target);
+		}
+	}
+	else if (entry != NULL)
+	{
+		if ((clicks == 2) || ((clicks == 3) && (entry->down_label != NULL)))
+		{
+			set_value(entry, step_value(entry, get_value(entry), clicks == 2));
+			draw_value(entry);
+			oled_flush();
+		}
+	}
+	MYLOG("BTN", "%dx Menu Level %d", clicks, sel_menu);
+}
@@ -23,34 +23,249 @@ void oled_show(void);
 #define LINE_HEIGHT 10
 
 /** Number of message lines */
-#define NUM_OF_LINES (OLED_HEIGHT - STATUS_BAR_HEIGHT) / LINE_HEIGHT
+#define NUM_OF_LINES ((OLED_HEIGHT - STATUS_BAR_HEIGHT) / LINE_HEIGHT)
 
-/** Line buffer for messages */
-char disp_buffer[NUM_OF_LINES + 1][32] = {0};
+/** Line buffer for messages, ring buffer starting at first_line */
+char disp_buffer[NUM_OF_LINES][32] = {0};
 
-/** Current line used */
+/** Number of lines used */
 uint8_t current_line = 0;
 
+/** Ring buffer index of the top line */
+uint8_t first_line = 0;
+
+/** I2C address of the display */
+#define OLED_ADDRESS 0x3c
+/** Number of 8 pixel high pages of the display */
+#define OLED_PAGES (OLED_HEIGHT / 8)
+/** Max number of data bytes per I2C transfer (Wire buffer is 32 bytes) */
+#define OLED_CHUNK 16
+
+/**
+ * @brief SSD1306 display that sends only the changed columns of each page
+ *     A copy of the last sent framebuffer is kept to find the changed ranges
+ */
+class SSD1306Partial : public SSD1306Wire
+{
+public:
+	using SSD1306Wire::SSD1306Wire;
+	void display(void);
+	void scroll_left(uint8_t first_page, uint8_t last_page);
+	bool get_pixel(int16_t x, int16_t y);
+
+	/** Number of display updates */
+	uint32_t flush_count = 0;
+	/** Number of bytes sent over I2C, including address bytes */
+	uint32_t bus_bytes = 0;
+	/** Bytes sent for the last display update */
+	uint32_t last_bytes = 0;
+	/** Time used for the last display update in us */
+	uint32_t last_time = 0;
+
+private:
+	void send_range(uint8_t page, uint8_t first, uint8_t last);
+
+	/** Framebuffer content as sent to the display */
+	uint8_t sent_buffer[OLED_WIDTH * OLED_PAGES];
+	/** Flag to send the complete framebuffer on the next update */
+	bool full_refresh = true;
+};
+
+/**
+ * @brief Send the changed parts of the framebuffer to the display
+ *
+ */
+void SSD1306Partial::display(void)
+{
+	uint32_t start = micros();
+	uint32_t start_bytes = bus_bytes;
+	for (uint8_t page = 0; page < OLED_PAGES; page++)
+	{
+		uint8_t *new_page = &buffer[page * OLED_WIDTH];
+		uint8_t *sent_page = &sent_buffer[page * OLED_WIDTH];
+		int16_t first = -1;
+		int16_t last = -1;
+		if (full_refresh)
+		{
+			first = 0;
+			last = OLED_WIDTH - 1;
+		}
+		else
+		{
+			for (int16_t col = 0; col < OLED_WIDTH; col++)
+			{
+				if (new_page[col] != sent_page[col])
+				{
+					if (first < 0)
+					{
+						first = col;
+					}
+					last = col;
+				}
+			}
+		}
+		if (first >= 0)
+		{
+			send_range(page, first, last);
+			memcpy(&sent_page[first], &new_page[first], last - first + 1);
+		}
+	}
+	full_refresh = false;
+	flush_count++;
+	last_bytes = bus_bytes - start_bytes;
+	last_time = micros() - start;
+}
+
+/**
+ * @brief Send a range of columns of one page to the display
+ *
+ * @param page page number 0 to 7
+ * @param first first column
+ * @param last last column
+ */
+void SSD1306Partial::send_range(uint8_t page, uint8_t first, uint8_t last)
+{
+	// Set the address window, 0x21 = column address, 0x22 = page address
+	Wire.beginTransmission(OLED_ADDRESS);
+	Wire.write(0x00);
+	Wire.write(0x21);
+	Wire.write(first);
+	Wire.write(last);
+	Wire.write(0x22);
+	Wire.write(page);
+	Wire.write(page);
+	Wire.endTransmission();
+	bus_bytes += 8;
+
+	uint8_t *data = &buffer[page * OLED_WIDTH];
+	for (uint16_t col = first; col <= last; col += OLED_CHUNK)
+	{
+		Wire.beginTransmission(OLED_ADDRESS);
+		Wire.write(0x40);
+		bus_bytes += 2;
+		for (uint16_t idx = col; (idx < col + OLED_CHUNK) && (idx <= last); idx++)
+		{
+			Wire.write(data[idx]);
+			bus_bytes++;
+		}
+		Wire.endTransmission();
+	}
+}
+
+/**
+ * @brief Get a pixel from the framebuffer
+ *
+ * @param x column
+ * @param y row
+ * @return true if the pixel is set
+ */
+bool SSD1306Partial::get_pixel(int16_t x, int16_t y)
+{
+	return (buffer[(y / 8) * OLED_WIDTH + x] & (1 << (y & 7))) != 0;
+}
+
+/**
+ * @brief Move the content of a range of pages one column to the left
+ *     The rightmost column is cleared
+ *
+ * @param first_page first page to move
+ * @param last_page last page to move
+ */
+void SSD1306Partial::scroll_left(uint8_t first_page, uint8_t last_page)
+{
+	for (uint8_t page = first_page; page <= last_page; page++)
+	{
+		uint8_t *data = &buffer[page * OLED_WIDTH];
+		memmove(data, &data[1], OLED_WIDTH - 1);
+		data[OLED_WIDTH - 1] = 0;
+	}
+}
+
 /** Display class using Wire */
-SSD1306Wire display(0x3c, PIN_WIRE_SDA, PIN_WIRE_SCL, GEOMETRY_128_64, &Wire);
+SSD1306Partial display(OLED_ADDRESS, PIN_WIRE_SDA, PIN_WIRE_SCL, GEOMETRY_128_64, &Wire);
 
 /** Flag if display is on or off */
 volatile bool display_power = true;
+/** Flag if the display content changed while the display was off */
+bool render_skipped = false;
+/** Last header text, used to redraw the display after it was off */
+char last_header[32] = {0};
+
+/** Minimum time between two display updates in ms, max 5 updates per second */
+#define OLED_FRAME_TIME 200
+/** Flag if a display update is waiting */
+volatile bool frame_pending = false;
+/** Time of the last display update */
+uint32_t last_frame = 0;
+/** Flag if the renderer task is running, before that updates are sent immediately */
+bool renderer_running = false;
+
+/** Number of samples in the graph, one per pixel column */
+#define GRAPH_SAMPLES OLED_WIDTH
+/** First page of the RSSI graph */
+#define GRAPH_RSSI_PAGE 2
+/** First page of the SNR graph */
+#define GRAPH_SNR_PAGE 5
+/** Number of pages per graph */
+#define GRAPH_PAGES 3
+/** Height of a graph in pixel, 1 pixel gap between the graphs */
+#define GRAPH_HEIGHT (GRAPH_PAGES * 8 - 1)
+
+/** Ring buffer with RSSI samples */
+int16_t graph_rssi[GRAPH_SAMPLES];
+/** Ring buffer with SNR samples */
+int16_t graph_snr[GRAPH_SAMPLES];
+/** Ring buffer index of the oldest sample */
+uint8_t graph_first = 0;
+/** Number of samples in the ring buffer */
+uint8_t graph_count = 0;
+/** Flag if the graph view is selected */
+bool g_graph_view = false;
+/** Flag if the graph on the display is complete */
+bool graph_valid = false;
+
+/** Graph scale, lowest and highest value of the RSSI and SNR graph */
+struct graph_scale_s
+{
+	int16_t rssi_low;
+	int16_t rssi_high;
+	int16_t snr_low;
+	int16_t snr_high;
+};
+/** Current graph scale */
+graph_scale_s graph_scale = {0, 0, 0, 0};
+/** Lowest and highest sample in the graphs, not rounded */
+graph_scale_s graph_limits = {0, 0, 0, 0};
+
+static void graph_draw_all(void);
+
+/**
+ * @brief Check if the graph view is on the display
+ *     The settings UI has priority over the graph view
+ *
+ * @return true if the graph view is shown
+ */
+static bool graph_shown(void)
+{
+	return g_graph_view && !g_settings_ui;
+}
 
-// Forward declarations for UI
-extern uint8_t ui_last_dr;
-extern uint8_t ui_max_dr;
-extern uint8_t ui_min_dr;
-extern uint8_t ui_last_band;
-extern uint8_t ui_last_adr;
-extern uint8_t ui_last_tx;
-extern uint8_t ui_max_tx;
-extern uint8_t ui_min_tx;
-extern uint32_t ui_p2p_freq;
-extern uint8_t ui_p2p_sf;
-extern uint8_t ui_p2p_bw;
-extern uint8_t ui_p2p_cr;
-extern uint8_t ui_p2p_tx;
+/**
+ * @brief Check if the display is off
+ *     Nothing is sent to the display, the text view is still drawn into the
+ *     framebuffer and the graph is drawn once when the display is switched on
+ *
+ * @return true if the display is off
+ */
+static bool display_dark(void)
+{
+	if (!display_power)
+	{
+		render_skipped = true;
+		return true;
+	}
+	return false;
+}
 
 /**
  * @brief Initialize the display
@@ -74,16 +289,25 @@ bool init_oled(void)
 #endif
 	display.setContrast(100, 241, 64);
 	display.setFont(ArialMT_Plain_10);
-	display.display();
+	oled_flush();
 
 	return true;
 }
 
 /**
  * @brief Write the top line of the display
+ *     Only draws into the framebuffer, the caller sends the complete update
  */
 void oled_write_header(char *header_line)
 {
+	if (!graph_shown())
+	{
+		snprintf(last_header, sizeof(last_header), "%s", header_line);
+	}
+	if (graph_shown() && display_dark())
+	{
+		return;
+	}
 	display.setFont(ArialMT_Plain_10);
 
 	// clear the status bar
@@ -93,25 +317,31 @@ void oled_write_header(char *header_line)
 	display.setColor(WHITE);
 	display.setTextAlignment(TEXT_ALIGN_LEFT);
 
-	display.drawString(0, 0, header_line);
-
 	uint16_t len = 0;
 	char oled_line[64];
+	if (graph_shown())
+	{
+		// Body was used by another screen
+		if (!graph_valid)
+		{
+			graph_draw_all();
+		}
+		// Highest/lowest sample of the graphs
+		sprintf(oled_line, "R%d/%d S%d/%d", graph_limits.rssi_high, graph_limits.rssi_low, graph_limits.snr_high, graph_limits.snr_low);
+		display.drawString(0, 0, oled_line);
+	}
+	else
+	{
+		display.drawString(0, 0, header_line);
+	}
+
 #ifdef _VARIANT_RAK4630_
 	uint8_t usbStatus = NRF_POWER->USBREGSTATUS;
 	switch (usbStatus)
 	{
 	case 0:
 	{
-		float bat = api.system.bat.get();
-		bat = 0.0;
-		for (int idx = 0; idx < 10; idx++)
-		{
-			bat += api.system.bat.get();
-		}
-		bat = bat / 10.0;
-
-		len = sprintf(oled_line, "%.2fV", bat);
+		len = sprintf(oled_line, "%d.%02dV", g_battery_mv / 1000, (g_battery_mv % 1000) / 10);
 		display.drawString(127 - (display.getStringWidth(oled_line, len)), 0, oled_line);
 		break;
 	}
@@ -125,25 +355,30 @@ void oled_write_header(char *header_line)
 		break;
 	}
 #else
-	float bat = api.system.bat.get();
-	bat = 0.0;
-	for (int idx = 0; idx < 10; idx++)
-	{
-		bat += api.system.bat.get();
-	}
-	bat = bat / 10.0;
-
-	len = sprintf(oled_line, "%.2fV", bat);
+	len = sprintf(oled_line, "%d.%02dV", g_battery_mv / 1000, (g_battery_mv % 1000) / 10);
 	display.drawString(127 - (display.getStringWidth(oled_line, len)), 0, oled_line);
 #endif
 
 	// draw divider line
 	display.drawLine(0, 11, 127, 11);
-	display.display();
+}
+
+/**
+ * @brief Draw one line of the message buffer
+ *     The line area must be empty, descenders reach into the next line
+ *
+ * @param line line number on the display
+ */
+static void oled_draw_line(uint8_t line)
+{
+	display.drawString(0, (line * LINE_HEIGHT) + STATUS_BAR_HEIGHT + 1, disp_buffer[(first_line + line) % NUM_OF_LINES]);
 }
 
 /**
  * @brief Add a line to the display buffer
+ *     Without scrolling only the new line is drawn.
+ *     The display update is sent by the renderer, so lines added
+ *     within one event are sent together
  *
  * @param line Pointer to char array with the new line
  */
@@ -151,21 +386,27 @@ void oled_add_line(char *line)
 {
 	if (current_line == NUM_OF_LINES)
 	{
-		// Display is full, shift text one line up
-		for (int idx = 0; idx < NUM_OF_LINES; idx++)
-		{
-			memcpy(disp_buffer[idx], disp_buffer[idx + 1], 32);
-		}
-		current_line--;
+		// Display is full, the oldest line is replaced and all lines move up
+		snprintf(disp_buffer[first_line], 32, "%s", line);
+		first_line = (first_line + 1) % NUM_OF_LINES;
+		oled_show();
+		return;
 	}
-	snprintf(disp_buffer[current_line], 32, "%s", line);
 
-	if (current_line != NUM_OF_LINES)
+	// Area below the last line is empty, draw only the new line
+	snprintf(disp_buffer[(first_line + current_line) % NUM_OF_LINES], 32, "%s", line);
+	if (graph_shown())
 	{
+		// Keep the line for the text view
 		current_line++;
+		return;
 	}
-
-	oled_show();
+	display.setFont(ArialMT_Plain_10);
+	display.setColor(WHITE);
+	display.setTextAlignment(TEXT_ALIGN_LEFT);
+	oled_draw_line(current_line);
+	current_line++;
+	oled_display();
 }
 
 /**
@@ -174,6 +415,10 @@ void oled_add_line(char *line)
  */
 void oled_show(void)
 {
+	if (graph_shown())
+	{
+		return;
+	}
 	display.setColor(BLACK);
 	display.fillRect(0, STATUS_BAR_HEIGHT + 1, OLED_WIDTH, OLED_HEIGHT);
 
@@ -182,9 +427,9 @@ void oled_show(void)
 	display.setTextAlignment(TEXT_ALIGN_LEFT);
 	for (int line = 0; line < current_line; line++)
 	{
-		display.drawString(0, (line * LINE_HEIGHT) + STATUS_BAR_HEIGHT + 1, disp_buffer[line]);
+		oled_draw_line(line);
 	}
-	display.display();
+	oled_display();
 }
 
 /**
@@ -193,10 +438,16 @@ void oled_show(void)
  */
 void oled_clear(void)
 {
+	current_line = 0;
+	first_line = 0;
+	if (graph_shown())
+	{
+		return;
+	}
 	display.setColor(BLACK);
 	display.fillRect(0, STATUS_BAR_HEIGHT + 1, OLED_WIDTH, OLED_HEIGHT);
 	display.setColor(WHITE);
-	current_line = 0;
+	graph_valid = false;
 }
 
 /**
@@ -208,20 +459,85 @@ void oled_clear(void)
  */
 void oled_write_line(int16_t line, int16_t y_pos, String text)
 {
+	if (graph_shown())
+	{
+		return;
+	}
 	display.drawString(y_pos, (line * LINE_HEIGHT) + STATUS_BAR_HEIGHT + 1, text);
 }
 
 /**
- * @brief Display the buffer
+ * @brief Clear lines from a given position to the right border
+ *     The area includes the descenders of the last line
+ *
+ * @param line first line to clear
+ * @param x_pos x position to start
+ * @param lines number of lines to clear
+ */
+void oled_clear_line(int16_t line, int16_t x_pos, int16_t lines)
+{
+	if (graph_shown())
+	{
+		return;
+	}
+	display.setColor(BLACK);
+	display.fillRect(x_pos, (line * LINE_HEIGHT) + STATUS_BAR_HEIGHT + 1, OLED_WIDTH - x_pos, (lines * LINE_HEIGHT) + 3);
+	display.setColor(WHITE);
+}
+
+/**
+ * @brief Request a display update
+ *     The update is sent by oled_render_task, several requests
+ *     within one frame time are sent as one update.
+ *     During setup the update is sent immediately
  *
  */
 void oled_display(void)
 {
+	if (display_dark())
+	{
+		return;
+	}
+	if (!renderer_running)
+	{
+		oled_flush();
+		return;
+	}
+	frame_pending = true;
+}
+
+/**
+ * @brief Send the buffer to the display immediately
+ *     Used for button actions and before blocking actions like reboot
+ *
+ */
+void oled_flush(void)
+{
+	frame_pending = false;
+	if (display_dark())
+	{
+		return;
+	}
+	last_frame = millis();
 	display.display();
 }
 
 /**
- * @brief Timer callback for display saver
+ * @brief Renderer task, sends a waiting display update
+ *     but not more often than every OLED_FRAME_TIME ms
+ *
+ */
+void oled_render_task(void)
+{
+	renderer_running = true;
+	if (frame_pending && ((millis() - last_frame) >= OLED_FRAME_TIME))
+	{
+		oled_flush();
+	}
+}
+
+/**
+ * @brief Display saver, called from timer_task when timer 2 expired
  * 
  */
 void oled_saver(void *)
@@ -231,6 +547,9 @@ void oled_saver(void *)
 
 /**
  * @brief Switch display on/off
+ *     While the display is off the framebuffer is not sent. The text view
+ *     is kept up to date in the framebuffer, the graph is drawn again.
+ *     The display gets one update when it is switched on again
  *
  * @param on_off true == Display on, false == Display off
  */
@@ -240,6 +559,17 @@ void oled_power(bool on_off)
 	{
 		display.displayOn();
 		display_power = true;
+		if (render_skipped)
+		{
+			// Send the content that changed while the display was off
+			render_skipped = false;
+			if (graph_shown())
+			{
+				graph_valid = false;
+				oled_write_header(last_header);
+			}
+			oled_flush();
+		}
 		// Restart display saver timer if enabled
 		if (g_custom_parameters.display_saver)
 		{
@@ -254,235 +584,219 @@ void oled_power(bool on_off)
 }
 
 /**
- * @brief Settings display handler
- * 
- * @param menu which menu content to show
- * @param menu_len number of menu items
- * @param sel_menu selected menu
- * @param sel_item selected item
- * @param display_saver status display saver
- * @param location_on status location module power saver
+ * @brief Round a value down to a multiple of 5
+ *
+ * @param value value to round
+ * @return int16_t rounded value
  */
-void display_show_menu(char *menu[], uint8_t menu_len, uint8_t sel_menu, uint8_t sel_item, bool display_saver, bool location_on)
+static int16_t graph_floor5(int16_t value)
 {
-	// char line[64];
-	oled_clear();
-	uint16_t y_pos = 0;
-	uint16_t line_pos = 0;
+	return (value >= 0) ? (value / 5) * 5 : -(((-value + 4) / 5) * 5);
+}
 
-	// Handle info menu
-	if (sel_menu == T_INFO_MENU)
+/**
+ * @brief Get the y position of a value in a graph
+ *
+ * @param value sample value
+ * @param low lowest value of the graph scale
+ * @param high highest value of the graph scale
+ * @param page first page of the graph
+ * @return int16_t y position in pixel
+ */
+static int16_t graph_y(int16_t value, int16_t low, int16_t high, uint8_t page)
+{
+	int16_t bottom = page * 8 + GRAPH_HEIGHT - 1;
+	return bottom - ((int32_t)(value - low) * (GRAPH_HEIGHT - 1)) / (high - low);
+}
+
+/**
+ * @brief Draw one sample column of both graphs
+ *     The column connects to the previous sample to draw a line
+ *
+ * @param sample sample number, 0 is the oldest sample
+ */
+static void graph_draw_column(uint8_t sample)
+{
+	int16_t x_pos = OLED_WIDTH - graph_count + sample;
+	uint8_t idx = (graph_first + sample) % GRAPH_SAMPLES;
+	uint8_t prev_idx = (sample == 0) ? idx : (idx + GRAPH_SAMPLES - 1) % GRAPH_SAMPLES;
+
+	int16_t y_pos = graph_y(graph_rssi[idx], graph_scale.rssi_low, graph_scale.rssi_high, GRAPH_RSSI_PAGE);
+	int16_t y_prev = graph_y(graph_rssi[prev_idx], graph_scale.rssi_low, graph_scale.rssi_high, GRAPH_RSSI_PAGE);
+	display.drawLine(x_pos, y_prev, x_pos, y_pos);
+
+	y_pos = graph_y(graph_snr[idx], graph_scale.snr_low, graph_scale.snr_high, GRAPH_SNR_PAGE);
+	y_prev = graph_y(graph_snr[prev_idx], graph_scale.snr_low, graph_scale.snr_high, GRAPH_SNR_PAGE);
+	display.drawLine(x_pos, y_prev, x_pos, y_pos);
+}
+
+/**
+ * @brief Find the lowest and highest sample in the ring buffer
+ *
+ * @return graph_scale_s lowest and highest RSSI and SNR
+ */
+static graph_scale_s graph_get_limits(void)
+{
+	graph_scale_s limits = {0x7FFF, -0x7FFF, 0x7FFF, -0x7FFF};
+	for (uint8_t sample = 0; sample < graph_count; sample++)
 	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		switch (g_last_settings.test_mode)
-		{
-		case MODE_LINKCHECK:
-			oled_write_line(1, 0, (char *)"LinkCheck Mode");
-			break;
-		case MODE_P2P:
-			oled_write_line(1, 0, (char *)"P2P Mode");
-			break;
-		case MODE_FIELDTESTER:
-			oled_write_line(1, 0, (char *)"Field Tester mode");
-			break;
-		}
-		sprintf(line_str, "Sent interval %ds", g_last_settings.send_interval / 1000);
-		oled_write_line(2, 0, line_str);
-		sprintf(line_str, "Location %s", location_on ? "on" : "off");
-		oled_write_line(3, 0, line_str);
-		sprintf(line_str, "Display saver %s", display_saver ? "on" : "off");
-		oled_write_line(4, 0, line_str);
-	}
-	// Handle send interval menu
-	else if (sel_menu == S_SEND_INT)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) 10 seconds more");
-		oled_write_line(2, 0, (char *)"(3) 10 seconds less");
-		sprintf(line_str, "              ==>  %ld s", g_last_settings.send_interval / 1000);
-		oled_write_line(4, 0, line_str);
-	}
-	// Handle LoRaWAN band selection
-	else if (sel_menu == S_LPW_BAND)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) Next");
-		oled_write_line(2, 0, (char *)"(3) Prev");
-		uint8_t prev_item = sel_item == 0 ? 12 : sel_item - 1;
-		uint8_t next_item = sel_item == 12 ? 0 : sel_item + 1;
-		sprintf(line_str, "%s", g_regions_list[prev_item]);
-		oled_write_line(2, 64, line_str);
-		sprintf(line_str, "==>  %s", g_regions_list[sel_item]);
-		oled_write_line(3, 64, line_str);
-		sprintf(line_str, "%s", g_regions_list[next_item]);
-		oled_write_line(4, 64, line_str);
-	}
-	// Handle LoRaWAN ADR selection
-	else if (sel_menu == S_LPW_ADR)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		if (sel_item == 10)
-		{
-			sprintf(line_str, "(2) ADR OFF");
-		}
-		else
-		{
-			sprintf(line_str, "(2) ADR ON");
-		}
+		uint8_t idx = (graph_first + sample) % GRAPH_SAMPLES;
+		limits.rssi_low = min(limits.rssi_low, graph_rssi[idx]);
+		limits.rssi_high = max(limits.rssi_high, graph_rssi[idx]);
+		limits.snr_low = min(limits.snr_low, graph_snr[idx]);
+		limits.snr_high = max(limits.snr_high, graph_snr[idx]);
+	}
+	return limits;
+}
 
-		oled_write_line(1, 0, line_str);
-	}
-	// Handle LoRaWAN DR selection
-	else if (sel_menu == S_LPW_DR)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) Next");
-		oled_write_line(2, 0, (char *)"(3) Prev");
-		uint8_t prev_item = (ui_last_dr == ui_min_dr ? ui_max_dr : ui_last_dr - 1);
-		uint8_t next_item = (ui_last_dr == ui_max_dr ? ui_min_dr : ui_last_dr + 1);
-		sprintf(line_str, "DR%d", prev_item);
-		oled_write_line(2, 64, line_str);
-		sprintf(line_str, "==>  DR%d", ui_last_dr);
-		oled_write_line(3, 64, line_str);
-		sprintf(line_str, "DR%d", next_item);
-		oled_write_line(4, 64, line_str);
-	}
-	// Handle LoRaWAN TX selection
-	else if (sel_menu == S_LPW_TX)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) Next");
-		oled_write_line(2, 0, (char *)"(3) Prev");
-		uint8_t prev_item = (ui_last_tx == ui_min_tx ? ui_max_tx : ui_last_tx - 1);
-		uint8_t next_item = (ui_last_tx == ui_max_tx ? ui_min_tx : ui_last_tx + 1);
-		sprintf(line_str, "TXP %d", prev_item);
-		oled_write_line(2, 64, line_str);
-		sprintf(line_str, "==>  TXP %d", ui_last_tx);
-		oled_write_line(3, 64, line_str);
-		sprintf(line_str, "TXP %d", next_item);
-		oled_write_line(4, 64, line_str);
-	}
-	// Handle P2P frequency menu
-	else if (sel_menu == S_P2P_FREQ)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) 0.1MHz up");
-		oled_write_line(2, 0, (char *)"(3) 0.1MHz down");
-		sprintf(line_str, "              ==>  %.3f MHz", (long)ui_p2p_freq / 1000000.0);
-		oled_write_line(4, 0, line_str);
-	}
-	// Handle P2P SF menu
-	else if (sel_menu == S_P2P_SF)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) Next");
-		oled_write_line(2, 0, (char *)"(3) Prev");
-		uint8_t prev_item = (sel_item == 6 ? 12 : sel_item - 1);
-		uint8_t next_item = (sel_item == 12 ? 6 : sel_item + 1);
-		sprintf(line_str, "SF %d", prev_item);
-		oled_write_line(2, 64, line_str);
-		sprintf(line_str, "==>  SF %d", sel_item);
-		oled_write_line(3, 64, line_str);
-		sprintf(line_str, "SF %d", next_item);
-		oled_write_line(4, 64, line_str);
-	}
-	// Handle P2P BW menu
-	else if (sel_menu == S_P2P_BW)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) Next");
-		oled_write_line(2, 0, (char *)"(3) Prev");
-		uint8_t prev_item = (sel_item == 0 ? 9 : sel_item - 1);
-		uint8_t next_item = (sel_item == 9 ? 0 : sel_item + 1);
-		sprintf(line_str, "BW %skHz", p_bw_menu[prev_item]);
-		oled_write_line(2, 44, line_str);
-		sprintf(line_str, "==>  BW %skHz", p_bw_menu[sel_item]);
-		oled_write_line(3, 44, line_str);
-		sprintf(line_str, "BW %skHz", p_bw_menu[next_item]);
-		oled_write_line(4, 44, line_str);
-	}
-	// Handle P2P SF menu
-	else if (sel_menu == S_P2P_CR)
-	{
-		oled_write_line(0, 0, (char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) Next");
-		oled_write_line(2, 0, (char *)"(3) Prev");
-		uint8_t prev_item = (sel_item == 0 ? 3 : sel_item - 1);
-		uint8_t next_item = (sel_item == 3 ? 0 : sel_item + 1);
-		sprintf(line_str, "CR 4/%d", prev_item + 5);
-		oled_write_line(2, 64, line_str);
-		sprintf(line_str, "==>  CR 4/%d", sel_item + 5);
-		oled_write_line(3, 64, line_str);
-		sprintf(line_str, "CR 4/%d", next_item + 5);
-		oled_write_line(4, 64, line_str);
-	}
-	// Handle P2P TX selection
-	else if (sel_menu == S_P2P_TX)
-	{
-		oled_write_line(0,0,(char *)"(1) Back");
-		oled_write_line(1, 0, (char *)"(2) Next");
-		oled_write_line(2, 0, (char *)"(3) Prev");
-		uint8_t prev_item = (sel_item == 5 ? 22 : sel_item - 1);
-		uint8_t next_item = (sel_item == 22 ? 5 : sel_item + 1);
-		sprintf(line_str, "TXP %d", prev_item);
-		oled_write_line(2, 64, line_str);
-		sprintf(line_str, "==>  TXP %d", sel_item);
-		oled_write_line(3, 64, line_str);
-		sprintf(line_str, "TXP %d", next_item);
-		oled_write_line(4, 64, line_str);
-	}
-	// Handle "standard" menu
+/**
+ * @brief Calculate the graph scale from the lowest and highest samples
+ *     The scale is rounded to 5 dB steps to avoid redraws on small changes
+ *
+ * @param limits lowest and highest samples
+ * @return graph_scale_s new scale
+ */
+static graph_scale_s graph_get_scale(graph_scale_s limits)
+{
+	graph_scale_s scale;
+	scale.rssi_low = graph_floor5(limits.rssi_low);
+	scale.rssi_high = graph_floor5(limits.rssi_high) + 5;
+	scale.snr_low = graph_floor5(limits.snr_low);
+	scale.snr_high = graph_floor5(limits.snr_high) + 5;
+	return scale;
+}
+
+/**
+ * @brief Draw the complete graph view
+ *
+ */
+static void graph_draw_all(void)
+{
+	display.setColor(BLACK);
+	display.fillRect(0, STATUS_BAR_HEIGHT + 1, OLED_WIDTH, OLED_HEIGHT);
+	display.setColor(WHITE);
+	if (graph_count == 0)
+	{
+		display.setFont(ArialMT_Plain_10);
+		display.setTextAlignment(TEXT_ALIGN_LEFT);
+		display.drawString(0, STATUS_BAR_HEIGHT + 1, "No samples yet");
+	}
+	for (uint8_t sample = 0; sample < graph_count; sample++)
+	{
+		graph_draw_column(sample);
+	}
+	graph_valid = true;
+}
+
+/**
+ * @brief Add a RSSI/SNR sample to the graph
+ *     If the graph is shown and the scale did not change,
+ *     the graph scrolls one column and only the new column is drawn
+ *
+ * @param rssi RSSI of the test
+ * @param snr SNR of the test
+ */
+void graph_add(int16_t rssi, int8_t snr)
+{
+	bool full = (graph_count == GRAPH_SAMPLES);
+	if (full)
+	{
+		graph_first = (graph_first + 1) % GRAPH_SAMPLES;
+	}
 	else
 	{
-		for (int idx = 0; idx < menu_len; idx++)
-		{
-			if (idx + 1 == sel_item)
-			{
-				sprintf(line_str, "(X) %s", menu[idx]);
-			}
-			else
-			{
-				// Handle settings menu special items
-				if ((sel_menu == T_SETT_MENU) && (idx == 2))
-				{
-					if (location_on)
-					{
-						sprintf(line_str, "(%d) %s on", idx + 1, menu[idx]);
-					}
-					else
-					{
-						sprintf(line_str, "(%d) %s off", idx + 1, menu[idx]);
-					}
-				}
-				else if ((sel_menu == T_SETT_MENU) && (idx == 3))
-				{
-					if (display_saver)
-					{
-						sprintf(line_str, "(%d) %s on", idx + 1, menu[idx]);
-					}
-					else
-					{
-						sprintf(line_str, "(%d) %s off", idx + 1, menu[idx]);
-					}
-				}
-				else
-				{
-					sprintf(line_str, "(%d) %s", idx + 1, menu[idx]);
-				}
-			}
+		graph_count++;
+	}
+	uint8_t idx = (graph_first + graph_count - 1) % GRAPH_SAMPLES;
+	graph_rssi[idx] = rssi;
+	graph_snr[idx] = snr;
 
-			if (idx > 4)
-			{
-				y_pos = 64;
-				line_pos = idx - 5;
-			}
-			else
-			{
-				y_pos = 0;
-				line_pos = idx;
-			}
-			oled_write_line(line_pos, y_pos, line_str);
-		}
+	graph_limits = graph_get_limits();
+	graph_scale_s scale = graph_get_scale(graph_limits);
+	bool rescale = memcmp(&scale, &graph_scale, sizeof(graph_scale_s)) != 0;
+	graph_scale = scale;
+
+	if (!has_oled || !graph_shown())
+	{
+		return;
+	}
+	if (display_dark())
+	{
+		// Complete graph is drawn when the display is switched on
+		graph_valid = false;
+		return;
 	}
+	if (rescale || !graph_valid || (graph_count == 1))
+	{
+		graph_draw_all();
+	}
+	else
+	{
+		display.scroll_left(GRAPH_RSSI_PAGE, GRAPH_SNR_PAGE + GRAPH_PAGES - 1);
+		graph_draw_column(graph_count - 1);
+	}
+	oled_write_header((char *)"");
 	oled_display();
 }
+
+/**
+ * @brief Switch between text view and graph view
+ *
+ */
+void graph_toggle(void)
+{
+	g_graph_view = !g_graph_view;
+	if (g_graph_view)
+	{
+		graph_draw_all();
+	}
+	else
+	{
+		oled_show();
+	}
+	oled_write_header((char *)"RAK Signal Meter");
+	oled_flush();
+}
+
+/**
+ * @brief Get the display transfer statistics
+ *
+ * @param flushes returns the number of display updates
+ * @param bytes returns the number of bytes sent over I2C
+ * @param last_bytes returns the bytes sent for the last update
+ * @param last_time returns the time of the last update in us
+ */
+void oled_get_stats(uint32_t *flushes, uint32_t *bytes, uint32_t *last_bytes, uint32_t *last_time)
+{
+	*flushes = display.flush_count;
+	*bytes = display.bus_bytes;
+	*last_bytes = display.last_bytes;
+	*last_time = display.last_time;
+}
+
+/**
+ * @brief Reset the display transfer statistics
+ *
+ */
+void oled_reset_stats(void)
+{
+	display.flush_count = 0;
+	display.bus_bytes = 0;
+	display.last_bytes = 0;
+	display.last_time = 0;
+}
+
+/**
+ * @brief Get one row of the framebuffer as PBM text (P1)
+ *
+ * @param row row number 0 to 63
+ * @param line buffer for the text, must be OLED_WIDTH + 1 bytes
+ */
+void oled_get_row(uint8_t row, char *line)
+{
+	for (int16_t col = 0; col < OLED_WIDTH; col++)
+	{
+		line[col] = display.get_pixel(col, row) ? '1' : '0';
+	}
+	line[OLED_WIDTH] = 0x00;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file payload.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Payload generator for the test packets
+ *     The generator fields are written in the order of the field list,
+ *     multi byte values are big endian:
+ *     C = packet counter, 4 bytes
+ *     U = uptime in seconds, 4 bytes
+ *     R = last RSSI, 2 bytes signed
+ *     S = last SNR, 1 byte signed
+ *     P = PRBS9 fill up to the packet size, only as last field
+ *     The packet size sweeps from min to max length in steps, the
+ *     remaining bytes without PRBS field are 0.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** TX buffer of the generator */
+uint8_t payload_buffer[128];
+/** Packet counter of the generator */
+uint32_t payload_counter = 0;
+/** Size of the next generated packet, 0 = start of the sweep */
+uint8_t payload_size = 0;
+
+/**
+ * @brief Get the size of a generator field
+ *
+ * @param field field code
+ * @return uint8_t size in bytes, 0 for the PRBS fill, 0xFF for an invalid field
+ */
+static uint8_t payload_field_size(char field)
+{
+	switch (field)
+	{
+	case 'C':
+	case 'U':
+		return 4;
+	case 'R':
+		return 2;
+	case 'S':
+		return 1;
+	case 'P':
+		return 0;
+	default:
+		return 0xFF;
+	}
+}
+
+/**
+ * @brief Check generator settings
+ *
+ * @param fields field list
+ * @param min_len shortest packet, must hold all fields
+ * @param max_len longest packet, max 128
+ * @param step size change per packet
+ * @return true if the settings are valid
+ */
+bool payload_check(const char *fields, uint8_t min_len, uint8_t max_len, uint8_t step)
+{
+	uint8_t num = strlen(fields);
+	uint8_t fixed = 0;
+	if ((num == 0) || (num > PCKG_FIELDS_MAX))
+	{
+		return false;
+	}
+	for (uint8_t idx = 0; idx < num; idx++)
+	{
+		uint8_t size = payload_field_size(fields[idx]);
+		if ((size == 0xFF) || ((size == 0) && (idx != num - 1)))
+		{
+			return false;
+		}
+		fixed += size;
+	}
+	return (min_len >= fixed) && (min_len != 0) && (min_len <= max_len) && (max_len <= 128) && (step != 0);
+}
+
+/**
+ * @brief Get the longest packet, used to select the datarate
+ *
+ * @return uint16_t longest packet length
+ */
+uint16_t payload_max_len(void)
+{
+	if (g_custom_parameters.pckg_fields[0] == 0)
+	{
+		return g_custom_parameters.custom_packet_len;
+	}
+	return g_custom_parameters.pckg_max;
+}
+
+/**
+ * @brief Restart the generator with the first packet of the sweep
+ *
+ */
+void payload_reset(void)
+{
+	payload_counter = 0;
+	payload_size = 0;
+}
+
+/**
+ * @brief Get the next test packet
+ *     Without generator the custom packet is used as it is,
+ *     otherwise the fields are written into the generator TX buffer
+ *
+ * @param len returns the packet length
+ * @return uint8_t* packet buffer
+ */
+uint8_t *payload_next(uint16_t *len)
+{
+	if (g_custom_parameters.pckg_fields[0] == 0)
+	{
+		*len = g_custom_parameters.custom_packet_len;
+		return g_custom_parameters.custom_packet;
+	}
+
+	// Next size of the sweep
+	if ((payload_size < g_custom_parameters.pckg_min) || (payload_size > g_custom_parameters.pckg_max))
+	{
+		payload_size = g_custom_parameters.pckg_min;
+	}
+	*len = payload_size;
+	if ((g_custom_parameters.pckg_max - payload_size) < g_custom_parameters.pckg_step)
+	{
+		payload_size = g_custom_parameters.pckg_min;
+	}
+	else
+	{
+		payload_size += g_custom_parameters.pckg_step;
+	}
+	payload_counter++;
+
+	uint8_t *pos = payload_buffer;
+	uint8_t *end = payload_buffer + *len;
+	uint32_t value = 0;
+	for (char *field = g_custom_parameters.pckg_fields; *field != 0; field++)
+	{
+		switch (*field)
+		{
+		case 'C':
+		case 'U':
+			value = (*field == 'C') ? payload_counter : millis() / 1000;
+			*pos++ = value >> 24;
+			*pos++ = value >> 16;
+			*pos++ = value >> 8;
+			*pos++ = value;
+			break;
+		case 'R':
+			*pos++ = (uint16_t)last_rssi >> 8;
+			*pos++ = last_rssi;
+			break;
+		case 'S':
+			*pos++ = last_snr;
+			break;
+		case 'P':
+		{
+			// PRBS9 x^9 + x^5 + 1, seeded by the counter, the receiver can check each packet on its own
+			uint16_t lfsr = (payload_counter % 511) + 1;
+			while (pos < end)
+			{
+				uint8_t byte = 0;
+				for (uint8_t bit = 0; bit < 8; bit++)
+				{
+					uint8_t new_bit = ((lfsr >> 8) ^ (lfsr >> 4)) & 0x01;
+					lfsr = ((lfsr << 1) | new_bit) & 0x1FF;
+					byte = (byte << 1) | new_bit;
+				}
+				*pos++ = byte;
+			}
+			break;
+		}
+		}
+	}
+	while (pos < end)
+	{
+		*pos++ = 0;
+	}
+	MYLOG("PCKG", "Generated packet %ld, %d bytes", payload_counter, *len);
+	return payload_buffer;
+}
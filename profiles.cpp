@@ -0,0 +1,275 @@
+/**
+ * @file profiles.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Named test profiles in flash
+ *     A profile bundles the test mode, interval, payload or payload generator,
+ *     location and the LoRa P2P and LoRaWAN radio settings. Applying a profile
+ *     changes all settings at once, a reboot is only required if the network
+ *     mode changes.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Size of a profile slot in flash, aligned to the flash write size */
+#define PROFILE_SLOT_SIZE ((sizeof(profile_s) + 7) & ~7)
+
+/**
+ * @brief Get the flash offset of a profile slot
+ *
+ * @param slot profile slot
+ * @return uint32_t flash offset
+ */
+static uint32_t profile_offset(uint8_t slot)
+{
+	return PROFILE_FLASH_START + slot * PROFILE_SLOT_SIZE;
+}
+
+/**
+ * @brief Read a profile and check it
+ *
+ * @param slot profile slot
+ * @param profile returns the profile
+ * @return true if the slot has a valid profile
+ */
+bool profile_get(uint8_t slot, profile_s *profile)
+{
+	if (slot >= PROFILE_MAX)
+	{
+		return false;
+	}
+	api.system.flash.get(profile_offset(slot), (uint8_t *)profile, sizeof(profile_s));
+	if (profile->crc != crc16((uint8_t *)profile, offsetof(profile_s, crc)))
+	{
+		return false;
+	}
+	// Do not trust the content, even if the CRC is correct
+	if ((profile->pckg_fields[PCKG_FIELDS_MAX] != 0) ||
+		((profile->pckg_fields[0] != 0) && !payload_check(profile->pckg_fields, profile->pckg_min, profile->pckg_max, profile->pckg_step)))
+	{
+		return false;
+	}
+	return (profile->test_mode <= MODE_FIELDTESTER) && (profile->custom_packet_len <= 128) && (profile->name[PROFILE_NAME_LEN - 1] == 0);
+}
+
+/**
+ * @brief Write a profile slot and read it back
+ *
+ * @param slot profile slot
+ * @param profile profile to write, all 0xFF to delete the profile
+ * @return true if the slot was written correct
+ */
+static bool profile_write(uint8_t slot, profile_s *profile)
+{
+	profile_s check;
+	if (!api.system.flash.set(profile_offset(slot), (uint8_t *)profile, sizeof(profile_s)))
+	{
+		MYLOG("PROF", "Write slot %d failed", slot);
+		return false;
+	}
+	api.system.flash.get(profile_offset(slot), (uint8_t *)&check, sizeof(profile_s));
+	return memcmp(profile, &check, sizeof(profile_s)) == 0;
+}
+
+/**
+ * @brief Save the current settings as profile
+ *     The radio settings of both network modes are stored
+ *
+ * @param slot profile slot
+ * @param name profile name, max PROFILE_NAME_LEN - 1 characters
+ * @return true if the profile was saved
+ */
+bool profile_store(uint8_t slot, const char *name)
+{
+	if ((slot >= PROFILE_MAX) || (strlen(name) >= PROFILE_NAME_LEN))
+	{
+		return false;
+	}
+
+	profile_s profile;
+	memset(&profile, 0, sizeof(profile_s));
+	strcpy(profile.name, name);
+	profile.send_interval = g_custom_parameters.send_interval;
+	profile.test_mode = g_custom_parameters.test_mode;
+	profile.location_on = g_custom_parameters.location_on;
+	profile.custom_packet_len = g_custom_parameters.custom_packet_len;
+	memcpy(profile.custom_packet, g_custom_parameters.custom_packet, g_custom_parameters.custom_packet_len);
+	memcpy(profile.pckg_fields, g_custom_parameters.pckg_fields, PCKG_FIELDS_MAX + 1);
+	profile.pckg_min = g_custom_parameters.pckg_min;
+	profile.pckg_max = g_custom_parameters.pckg_max;
+	profile.pckg_step = g_custom_parameters.pckg_step;
+	profile.p2p_freq = api.lora.pfreq.get();
+	profile.p2p_sf = api.lora.psf.get();
+	profile.p2p_bw = api.lora.pbw.get();
+	profile.p2p_cr = api.lora.pcr.get();
+	profile.p2p_tx = api.lora.ptp.get();
+	profile.lpw_band = api.lorawan.band.get();
+	profile.lpw_dr = api.lorawan.dr.get();
+	profile.lpw_tx = api.lorawan.txp.get();
+	profile.lpw_adr = api.lorawan.adr.get();
+	profile.crc = crc16((uint8_t *)&profile, offsetof(profile_s, crc));
+
+	MYLOG("PROF", "Save profile %d %s", slot, profile.name);
+	return profile_write(slot, &profile);
+}
+
+/**
+ * @brief Delete a profile
+ *
+ * @param slot profile slot
+ * @return true if the slot was erased
+ */
+bool profile_delete(uint8_t slot)
+{
+	if (slot >= PROFILE_MAX)
+	{
+		return false;
+	}
+	profile_s profile;
+	memset(&profile, 0xFF, sizeof(profile_s));
+	return profile_write(slot, &profile);
+}
+
+/**
+ * @brief Apply the radio settings of a profile for the current network mode
+ *     Only changed settings are written, a new region starts a new join
+ *
+ * @param profile profile to apply
+ */
+static void profile_radio(profile_s *profile)
+{
+	if (api.lorawan.nwm.get())
+	{
+		if (profile->lpw_adr != api.lorawan.adr.get())
+		{
+			api.lorawan.adr.set(profile->lpw_adr);
+		}
+		if (profile->lpw_dr != api.lorawan.dr.get())
+		{
+			api.lorawan.dr.set(profile->lpw_dr);
+		}
+		if (profile->lpw_tx != api.lorawan.txp.get())
+		{
+			api.lorawan.txp.set(profile->lpw_tx);
+		}
+		if (profile->lpw_band != api.lorawan.band.get())
+		{
+			api.lorawan.band.set(profile->lpw_band);
+			api.lorawan.join(1, 1, 10, 50);
+		}
+	}
+	else
+	{
+		// Radio settings can't be changed while RX is enabled
+		api.lora.precv(0);
+		if (profile->p2p_freq != api.lora.pfreq.get())
+		{
+			api.lora.pfreq.set(profile->p2p_freq);
+		}
+		if (profile->p2p_sf != api.lora.psf.get())
+		{
+			api.lora.psf.set(profile->p2p_sf);
+		}
+		if (profile->p2p_bw != api.lora.pbw.get())
+		{
+			api.lora.pbw.set(profile->p2p_bw);
+		}
+		if (profile->p2p_cr != api.lora.pcr.get())
+		{
+			api.lora.pcr.set(profile->p2p_cr);
+		}
+		if (profile->p2p_tx != api.lora.ptp.get())
+		{
+			api.lora.ptp.set(profile->p2p_tx);
+		}
+		// enable receive again
+		api.lora.precv(65533);
+	}
+	status_invalidate();
+}
+
+/**
+ * @brief Apply a profile
+ *     The profile is checked before anything is changed and the settings are
+ *     saved once. If the network mode changes, the radio settings are applied
+ *     by profile_resume() after the restart.
+ *
+ * @param slot profile slot
+ * @param restart returns true if the device must restart for the new test mode
+ * @return true if the profile was applied
+ * @return false if the slot has no valid profile or an uplink is in progress for a mode change
+ */
+bool profile_apply(uint8_t slot, bool *restart)
+{
+	profile_s profile;
+	*restart = false;
+	if (!profile_get(slot, &profile))
+	{
+		return false;
+	}
+	MYLOG("PROF", "Apply profile %d %s", slot, profile.name);
+
+	// The mode can not be switched while an uplink waits for its callback
+	if ((profile.test_mode != g_custom_parameters.test_mode) && tx_active)
+	{
+		MYLOG("PROF", "Uplink in progress, profile not applied");
+		return false;
+	}
+
+	api.system.timer.stop(RAK_TIMER_0);
+	bool location_changed = g_custom_parameters.location_on != profile.location_on;
+	g_custom_parameters.send_interval = profile.send_interval;
+	g_custom_parameters.location_on = profile.location_on;
+	g_custom_parameters.custom_packet_len = profile.custom_packet_len;
+	memcpy(g_custom_parameters.custom_packet, profile.custom_packet, profile.custom_packet_len);
+	memcpy(g_custom_parameters.pckg_fields, profile.pckg_fields, PCKG_FIELDS_MAX + 1);
+	g_custom_parameters.pckg_min = profile.pckg_min;
+	g_custom_parameters.pckg_max = profile.pckg_max;
+	g_custom_parameters.pckg_step = profile.pckg_step;
+	payload_reset();
+
+	if (switch_test_mode(profile.test_mode) == SWITCH_REBOOT)
+	{
+		// Switch between LoRaWAN and LoRa P2P, radio settings follow after the restart
+		g_custom_parameters.profile_pending = slot;
+		save_at_setting();
+		*restart = true;
+		return true;
+	}
+
+	profile_radio(&profile);
+
+	// Configure the GNSS for the new location setting, it stays powered only in Field Tester mode with location on
+	if (location_changed)
+	{
+		init_gnss(g_custom_parameters.test_mode == MODE_FIELDTESTER);
+		gnss_power_off();
+	}
+
+	save_at_setting();
+	start_send_timer();
+	return true;
+}
+
+/**
+ * @brief Apply the radio settings of a profile after the restart for a network mode change
+ *
+ */
+void profile_resume(void)
+{
+	if (g_custom_parameters.profile_pending == PROFILE_NONE)
+	{
+		return;
+	}
+	profile_s profile;
+	if (profile_get(g_custom_parameters.profile_pending, &profile))
+	{
+		MYLOG("PROF", "Resume profile %d %s", g_custom_parameters.profile_pending, profile.name);
+		profile_radio(&profile);
+	}
+	g_custom_parameters.profile_pending = PROFILE_NONE;
+	save_at_setting();
+}
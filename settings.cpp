@@ -0,0 +1,368 @@
+/**
+ * @file settings.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Custom settings record store in flash
+ *     Two flash pages are used alternately. Each page starts with a header,
+ *     followed by exactly one record per setting.
+ *     RUI3 flash.set erases and rewrites the complete page, so a save builds the
+ *     page image in RAM and writes it to the other page with a single flash.set.
+ *     The page in use is never touched, an interrupted write never destroys the settings.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Page header magic number */
+#define SETTINGS_MAGIC 0x54534553
+/** Schema version, increase if the meaning of a record ID changes */
+#define SETTINGS_VERSION 1
+/** Offset of the first record in a page */
+#define SETTINGS_FIRST_RECORD 16
+/** Records are aligned to the flash write size */
+#define SETTINGS_ALIGN 8
+/** Largest record data */
+#define SETTINGS_MAX_DATA 128
+/** Size of a record with ID, length, data and CRC */
+#define SETTINGS_RECORD_SIZE(len) ((4 + (len) + SETTINGS_ALIGN - 1) & ~(SETTINGS_ALIGN - 1))
+/** No valid page found */
+#define SETTINGS_NO_PAGE 0xFF
+/** Record ID of the custom packet, the data length is the packet length */
+#define SETTINGS_ID_PACKET 5
+
+/** Page header */
+struct settings_header_s
+{
+	uint32_t magic;		 // SETTINGS_MAGIC
+	uint32_t generation; // Incremented with each page change, highest is valid
+	uint16_t version;	 // Schema version
+	uint16_t crc;		 // CRC16 over the header without the CRC
+};
+
+/** Setting stored as record */
+struct settings_field_s
+{
+	uint8_t id;		 // Record ID, never reuse an ID for a different setting
+	uint16_t offset; // Offset in custom_param_s
+	uint8_t size;	 // Size in custom_param_s
+};
+
+/** Settings stored in the record store */
+const settings_field_s settings_fields[] = {
+	{1, offsetof(custom_param_s, send_interval), sizeof(uint32_t)},
+	{2, offsetof(custom_param_s, test_mode), sizeof(uint8_t)},
+	{3, offsetof(custom_param_s, display_saver), sizeof(bool)},
+	{4, offsetof(custom_param_s, location_on), sizeof(bool)},
+	{SETTINGS_ID_PACKET, offsetof(custom_param_s, custom_packet), SETTINGS_MAX_DATA},
+	{6, offsetof(custom_param_s, custom_packet_len), sizeof(uint16_t)},
+	{7, offsetof(custom_param_s, send_distance), sizeof(uint16_t)},
+	{8, offsetof(custom_param_s, skip_covered), sizeof(uint8_t)},
+	{9, offsetof(custom_param_s, telemetry), sizeof(bool)},
+	{10, offsetof(custom_param_s, instant_tx), sizeof(uint16_t)},
+	{11, offsetof(custom_param_s, profile_pending), sizeof(uint8_t)},
+	{12, offsetof(custom_param_s, pckg_fields), PCKG_FIELDS_MAX + 1},
+	{13, offsetof(custom_param_s, pckg_min), sizeof(uint8_t)},
+	{14, offsetof(custom_param_s, pckg_max), sizeof(uint8_t)},
+	{15, offsetof(custom_param_s, pckg_step), sizeof(uint8_t)},
+};
+/** Number of settings in the record store */
+#define SETTINGS_FIELDS (sizeof(settings_fields) / sizeof(settings_field_s))
+
+/** Page in use */
+uint8_t settings_page = SETTINGS_NO_PAGE;
+/** Generation of the page in use */
+uint32_t settings_generation = 0;
+/** Bytes used in the page in use */
+uint16_t settings_next = SETTINGS_FIRST_RECORD;
+/** RAM image of a settings page, used for writing and read back */
+uint8_t settings_image[APP_FLASH_PAGE_SIZE];
+/** Settings as stored in flash, used to find changed settings */
+custom_param_s settings_stored;
+/** Settings waiting for the background commit */
+custom_param_s settings_staged;
+/** Flag if staged settings wait for the commit */
+volatile bool settings_pending = false;
+/** Callback after the background commit */
+void (*settings_done)(bool result) = NULL;
+
+/**
+ * @brief Get the data length of a setting
+ *
+ * @param field setting description
+ * @param params settings
+ * @return uint8_t data length
+ */
+static uint8_t settings_data_len(const settings_field_s *field, const custom_param_s *params)
+{
+	if (field->id == SETTINGS_ID_PACKET)
+	{
+		return min(params->custom_packet_len, (uint16_t)SETTINGS_MAX_DATA);
+	}
+	return field->size;
+}
+
+/**
+ * @brief Check if a setting differs from the stored value
+ *
+ * @param field setting description
+ * @param params settings
+ * @return true if the setting changed
+ */
+static bool settings_changed(const settings_field_s *field, const custom_param_s *params)
+{
+	uint8_t len = settings_data_len(field, params);
+	if ((field->id == SETTINGS_ID_PACKET) && (settings_data_len(field, &settings_stored) != len))
+	{
+		return true;
+	}
+	return memcmp((uint8_t *)params + field->offset, (uint8_t *)&settings_stored + field->offset, len) != 0;
+}
+
+/**
+ * @brief Read and check the header of a page
+ *
+ * @param page page number
+ * @param header returns the header
+ * @return true if the header is valid
+ */
+static bool settings_read_header(uint8_t page, settings_header_s *header)
+{
+	api.system.flash.get(SETTINGS_FLASH_START + page * APP_FLASH_PAGE_SIZE, (uint8_t *)header, sizeof(settings_header_s));
+	return (header->magic == SETTINGS_MAGIC) && (header->crc == crc16((uint8_t *)header, offsetof(settings_header_s, crc)));
+}
+
+/**
+ * @brief Add a record to the page image
+ *
+ * @param offset offset in the page
+ * @param field setting description
+ * @param params settings
+ * @return uint16_t size of the record
+ */
+static uint16_t settings_put_record(uint16_t offset, const settings_field_s *field, const custom_param_s *params)
+{
+	uint8_t *record = &settings_image[offset];
+	uint8_t len = settings_data_len(field, params);
+
+	record[0] = field->id;
+	record[1] = len;
+	memcpy(&record[2], (uint8_t *)params + field->offset, len);
+	uint16_t crc = crc16(record, len + 2);
+	record[len + 2] = crc & 0xFF;
+	record[len + 3] = crc >> 8;
+	return SETTINGS_RECORD_SIZE(len);
+}
+
+/**
+ * @brief Write all settings to the other page
+ *     The page image with header and records is written with one flash.set
+ *     and read back, until then the old page stays valid
+ *
+ * @param params settings
+ * @return true if the settings were written
+ */
+static bool settings_compact(const custom_param_s *params)
+{
+	// Without a valid page, page 0 might hold settings of the old format
+	uint8_t page = (settings_page == 1) ? 0 : 1;
+	uint32_t page_start = SETTINGS_FLASH_START + page * APP_FLASH_PAGE_SIZE;
+
+	memset(settings_image, 0xFF, sizeof(settings_image));
+	settings_header_s header;
+	header.magic = SETTINGS_MAGIC;
+	header.generation = settings_generation + 1;
+	header.version = SETTINGS_VERSION;
+	header.crc = crc16((uint8_t *)&header, offsetof(settings_header_s, crc));
+	memcpy(settings_image, &header, sizeof(settings_header_s));
+
+	uint16_t next = SETTINGS_FIRST_RECORD;
+	for (uint8_t idx = 0; idx < SETTINGS_FIELDS; idx++)
+	{
+		next += settings_put_record(next, &settings_fields[idx], params);
+	}
+
+	if (!api.system.flash.set(page_start, settings_image, next))
+	{
+		MYLOG("SET", "Write to page %d failed", page);
+		return false;
+	}
+
+	// Read back, the image buffer is reused for the flash content
+	uint16_t crc = crc16(settings_image, next);
+	api.system.flash.get(page_start, settings_image, next);
+	if (crc16(settings_image, next) != crc)
+	{
+		MYLOG("SET", "Read back of page %d failed", page);
+		return false;
+	}
+
+	settings_page = page;
+	settings_generation = header.generation;
+	settings_next = next;
+	memcpy(&settings_stored, params, sizeof(custom_param_s));
+	MYLOG("SET", "Compacted to page %d, generation %ld, %d bytes", page, settings_generation, next);
+	return true;
+}
+
+/**
+ * @brief Read the settings from the record store
+ *     Settings in the old format (one structure at offset 0, starting with 0xAA)
+ *     are moved into the record store
+ *
+ * @param params returns the settings
+ * @return true if settings were found
+ */
+bool settings_load(custom_param_s *params)
+{
+	settings_header_s header[2];
+	bool valid[2];
+	valid[0] = settings_read_header(0, &header[0]);
+	valid[1] = settings_read_header(1, &header[1]);
+
+	if (!valid[0] && !valid[1])
+	{
+		settings_page = SETTINGS_NO_PAGE;
+		settings_generation = 0;
+
+		// Settings of older firmware versions, the old structure ends before send_distance.
+		// Behind it is padding and unwritten flash, these settings keep the default value.
+		custom_param_s defaults;
+		memcpy(params, &defaults, sizeof(custom_param_s));
+		api.system.flash.get(0, (uint8_t *)params, offsetof(custom_param_s, send_distance));
+		if (params->valid_flag != 0xAA)
+		{
+			return false;
+		}
+		if (params->custom_packet_len > SETTINGS_MAX_DATA)
+		{
+			params->custom_packet_len = 0;
+		}
+		// Old settings are in page 0, the first compaction writes to page 1
+		MYLOG("SET", "Move settings of old format");
+		settings_compact(params);
+		return true;
+	}
+
+	if (valid[0] && valid[1])
+	{
+		settings_page = (header[1].generation > header[0].generation) ? 1 : 0;
+	}
+	else
+	{
+		settings_page = valid[0] ? 0 : 1;
+	}
+	settings_generation = header[settings_page].generation;
+	if (header[settings_page].version != SETTINGS_VERSION)
+	{
+		MYLOG("SET", "Schema version %d, unknown records are skipped", header[settings_page].version);
+	}
+
+	// Settings missing in the page keep the default value
+	custom_param_s defaults;
+	memcpy(params, &defaults, sizeof(custom_param_s));
+
+	uint32_t page_start = SETTINGS_FLASH_START + settings_page * APP_FLASH_PAGE_SIZE;
+	uint8_t record[SETTINGS_RECORD_SIZE(SETTINGS_MAX_DATA)];
+	settings_next = SETTINGS_FIRST_RECORD;
+	while ((settings_next + SETTINGS_ALIGN) <= APP_FLASH_PAGE_SIZE)
+	{
+		api.system.flash.get(page_start + settings_next, record, SETTINGS_ALIGN);
+		if (record[0] == 0xFF)
+		{
+			// End of the records
+			break;
+		}
+		uint8_t len = record[1];
+		uint16_t size = SETTINGS_RECORD_SIZE(len);
+		if ((len > SETTINGS_MAX_DATA) || ((settings_next + size) > APP_FLASH_PAGE_SIZE))
+		{
+			// Broken record, the rest of the page is skipped
+			MYLOG("SET", "Invalid record at %d", settings_next);
+			settings_next = APP_FLASH_PAGE_SIZE;
+			break;
+		}
+		api.system.flash.get(page_start + settings_next, record, size);
+		if ((record[len + 2] | (record[len + 3] << 8)) != crc16(record, len + 2))
+		{
+			// Broken record, the rest of the page is skipped
+			MYLOG("SET", "CRC error in record at %d", settings_next);
+			settings_next = APP_FLASH_PAGE_SIZE;
+			break;
+		}
+		for (uint8_t idx = 0; idx < SETTINGS_FIELDS; idx++)
+		{
+			if ((settings_fields[idx].id == record[0]) && (len <= settings_fields[idx].size))
+			{
+				memcpy((uint8_t *)params + settings_fields[idx].offset, &record[2], len);
+				break;
+			}
+		}
+		settings_next += size;
+	}
+	memcpy(&settings_stored, params, sizeof(custom_param_s));
+	MYLOG("SET", "Page %d, generation %ld, %d bytes used", settings_page, settings_generation, settings_next);
+	return true;
+}
+
+/**
+ * @brief Write changed settings to the record store
+ *     Without changes nothing is written. Appending records to the page in use
+ *     would cost the same page erase as writing all settings to the other page,
+ *     and an interrupted append could destroy the page in use.
+ *
+ * @param params settings
+ * @return true if the settings were written
+ */
+bool settings_save(const custom_param_s *params)
+{
+	if (settings_page != SETTINGS_NO_PAGE)
+	{
+		bool changed = false;
+		for (uint8_t idx = 0; idx < SETTINGS_FIELDS; idx++)
+		{
+			changed |= settings_changed(&settings_fields[idx], params);
+		}
+		if (!changed)
+		{
+			MYLOG("SET", "No changes");
+			return true;
+		}
+	}
+	return settings_compact(params);
+}
+
+/**
+ * @brief Stage the current settings for the background commit
+ *     Returns immediately, settings_task writes the settings.
+ *     A second request before the commit replaces the first one.
+ *
+ * @param done callback after the commit with the result, can be NULL
+ */
+void settings_commit(void (*done)(bool result))
+{
+	memcpy(&settings_staged, &g_custom_parameters, sizeof(custom_param_s));
+	settings_done = done;
+	settings_pending = true;
+}
+
+/**
+ * @brief Background task, writes staged settings to flash
+ *     The callback is called after the records were written and read back
+ *
+ */
+void settings_task(void)
+{
+	if (!settings_pending)
+	{
+		return;
+	}
+	settings_pending = false;
+	bool result = settings_save(&settings_staged);
+	MYLOG("SET", "Commit %s", result ? "done" : "failed");
+	if (settings_done != NULL)
+	{
+		settings_done(result);
+	}
+}
@@ -0,0 +1,136 @@
+/**
+ * @file status.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Machine readable status line
+ *     The radio settings are read from a snapshot instead of the RUI3 API.
+ *     The snapshot is refreshed after the application changed a radio
+ *     setting and at least every STATUS_SNAPSHOT_AGE ms to catch changes
+ *     done with the RUI3 AT commands.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Max age of the radio snapshot in ms */
+#define STATUS_SNAPSHOT_AGE 10000
+
+/** Snapshot of the radio settings */
+struct radio_snapshot_s
+{
+	uint8_t nwm;	   // Network mode, 0 = LoRa P2P, 1 = LoRaWAN
+	bool joined;	   // LoRaWAN network joined
+	uint8_t band;	   // LoRaWAN region
+	uint8_t dr;		   // LoRaWAN datarate
+	uint8_t txp;	   // LoRaWAN TX power index
+	uint8_t adr;	   // LoRaWAN ADR
+	uint32_t freq;	   // LoRa P2P frequency in Hz
+	uint8_t sf;		   // LoRa P2P spreading factor
+	uint8_t bw;		   // LoRa P2P bandwidth index
+	uint8_t cr;		   // LoRa P2P coding rate index
+	uint8_t ptp;	   // LoRa P2P TX power
+};
+
+/** Radio settings snapshot */
+radio_snapshot_s radio_snapshot;
+/** Time of the last snapshot refresh */
+uint32_t radio_snapshot_time = 0;
+/** Flag if the snapshot must be refreshed */
+volatile bool radio_snapshot_dirty = true;
+
+/**
+ * @brief Mark the radio snapshot as outdated
+ *     Call after a radio setting was changed, safe to call from callbacks
+ *
+ */
+void status_invalidate(void)
+{
+	radio_snapshot_dirty = true;
+}
+
+/**
+ * @brief Read the radio settings of the current network mode into the snapshot
+ *
+ */
+static void status_refresh(void)
+{
+	radio_snapshot_dirty = false;
+	radio_snapshot_time = millis();
+	radio_snapshot.nwm = api.lorawan.nwm.get();
+	if (radio_snapshot.nwm == 1)
+	{
+		radio_snapshot.joined = api.lorawan.njs.get();
+		radio_snapshot.band = api.lorawan.band.get();
+		radio_snapshot.dr = api.lorawan.dr.get();
+		radio_snapshot.txp = api.lorawan.txp.get();
+		radio_snapshot.adr = api.lorawan.adr.get();
+	}
+	else
+	{
+		radio_snapshot.freq = api.lora.pfreq.get();
+		radio_snapshot.sf = api.lora.psf.get();
+		radio_snapshot.bw = api.lora.pbw.get();
+		radio_snapshot.cr = api.lora.pcr.get();
+		radio_snapshot.ptp = api.lora.ptp.get();
+	}
+}
+
+/**
+ * @brief Clamp the length of the status line
+ *     snprintf() returns the length the text would need, not the length written.
+ *     Without the clamp a truncated append moves the next one behind the buffer.
+ *
+ * @param len length after an append
+ * @return int length of the text in the buffer
+ */
+static int status_clamp(int len)
+{
+	return (len < STATUS_LINE_SIZE) ? len : STATUS_LINE_SIZE - 1;
+}
+
+/**
+ * @brief Build the status as one line of comma separated key=value pairs
+ *     Settings, radio settings of the current network mode, link statistics and counters
+ *
+ * @param buf output buffer, at least STATUS_LINE_SIZE bytes
+ * @return uint16_t number of characters written
+ */
+uint16_t status_line(char *buf)
+{
+	if (radio_snapshot_dirty || ((millis() - radio_snapshot_time) > STATUS_SNAPSHOT_AGE))
+	{
+		status_refresh();
+	}
+
+	int len = status_clamp(snprintf(buf, STATUS_LINE_SIZE, "mode=%d,nwm=%d,", g_custom_parameters.test_mode, radio_snapshot.nwm));
+	if (radio_snapshot.nwm == 1)
+	{
+		len += snprintf(buf + len, STATUS_LINE_SIZE - len, "joined=%d,band=%d,dr=%d,txp=%d,adr=%d,",
+						radio_snapshot.joined, radio_snapshot.band, radio_snapshot.dr, radio_snapshot.txp, radio_snapshot.adr);
+		len = status_clamp(len);
+	}
+	else
+	{
+		len += snprintf(buf + len, STATUS_LINE_SIZE - len, "freq=%ld,sf=%d,bw=%d,cr=%d,ptp=%d,",
+						radio_snapshot.freq, radio_snapshot.sf, radio_snapshot.bw, radio_snapshot.cr, radio_snapshot.ptp);
+		len = status_clamp(len);
+	}
+	len += snprintf(buf + len, STATUS_LINE_SIZE - len, "int=%ld,loc=%d,saver=%d,dist=%d,skip=%d,tlm=%d,itx=%d,plen=%d,",
+					g_custom_parameters.send_interval / 1000, g_custom_parameters.location_on, g_custom_parameters.display_saver,
+					g_custom_parameters.send_distance, g_custom_parameters.skip_covered, g_custom_parameters.telemetry,
+					g_custom_parameters.instant_tx, g_custom_parameters.custom_packet_len);
+	len = status_clamp(len);
+	len += snprintf(buf + len, STATUS_LINE_SIZE - len, "sent=%ld,lost=%ld,rssi=%d,snr=%d,rxdr=%d,gw=%d,margin=%d,fail=%ld,",
+					packet_num, packet_lost, last_rssi, last_snr, last_dr, link_check_gateways, link_check_demod_margin, tx_fail_status);
+	len = status_clamp(len);
+	len += snprintf(buf + len, STATUS_LINE_SIZE - len, "bat=%d,soc=%d,log=%d,grid=%d,up=%ld,sats=%d,",
+					g_battery_mv, g_battery_soc, g_log_count, g_grid_used, millis() / 1000, g_last_satellites);
+	len = status_clamp(len);
+	// fmt_location() has no size limit, the location needs max 33 characters
+	char location[40];
+	location[fmt_location(location, "lat=", ",lon=", g_last_lat, g_last_long, 7)] = 0;
+	len += snprintf(buf + len, STATUS_LINE_SIZE - len, "%s", location);
+	return status_clamp(len);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file telemetry.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Binary telemetry frames on the Serial port
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Size of a telemetry record including the CRC */
+#define TLM_RECORD_SIZE 28
+
+/**
+ * @brief COBS encode a buffer, the result contains no 0x00 bytes
+ *
+ * @param src data to encode
+ * @param len length of the data (max 253)
+ * @param dst buffer for the encoded data, must be len + 1 bytes
+ * @return uint8_t length of the encoded data
+ */
+static uint8_t cobs_encode(const uint8_t *src, uint8_t len, uint8_t *dst)
+{
+	uint8_t code_idx = 0;
+	uint8_t code = 1;
+	uint8_t dst_idx = 1;
+	for (uint8_t idx = 0; idx < len; idx++)
+	{
+		if (src[idx] == 0)
+		{
+			dst[code_idx] = code;
+			code_idx = dst_idx++;
+			code = 1;
+		}
+		else
+		{
+			dst[dst_idx++] = src[idx];
+			code++;
+		}
+	}
+	dst[code_idx] = code;
+	return dst_idx;
+}
+
+/**
+ * @brief Send a test result as COBS framed binary record
+ *     Record layout (little endian):
+ *     event u8, seq u32, time u32, mode u8, rssi i16, snr i8, margin i8,
+ *     gateways u8, lat i32, lon i32, battery mV u16, battery % u8,
+ *     crc16 u16 over the previous 26 bytes.
+ *     Each frame is terminated with 0x00
+ *
+ * @param event event type, same as the display reason
+ * @param record result as stored in the log
+ */
+void telemetry_send(uint8_t event, log_record_s *record)
+{
+	uint8_t tlm[TLM_RECORD_SIZE];
+	uint8_t frame[TLM_RECORD_SIZE + 2];
+
+	tlm[0] = event;
+	tlm[1] = (uint8_t)(record->seq);
+	tlm[2] = (uint8_t)(record->seq >> 8);
+	tlm[3] = (uint8_t)(record->seq >> 16);
+	tlm[4] = (uint8_t)(record->seq >> 24);
+	tlm[5] = (uint8_t)(record->time);
+	tlm[6] = (uint8_t)(record->time >> 8);
+	tlm[7] = (uint8_t)(record->time >> 16);
+	tlm[8] = (uint8_t)(record->time >> 24);
+	tlm[9] = record->mode;
+	tlm[10] = (uint8_t)(record->rssi);
+	tlm[11] = (uint8_t)(record->rssi >> 8);
+	tlm[12] = (uint8_t)record->snr;
+	tlm[13] = (uint8_t)record->margin;
+	tlm[14] = record->gateways;
+	tlm[15] = (uint8_t)(record->lat);
+	tlm[16] = (uint8_t)(record->lat >> 8);
+	tlm[17] = (uint8_t)(record->lat >> 16);
+	tlm[18] = (uint8_t)(record->lat >> 24);
+	tlm[19] = (uint8_t)(record->lon);
+	tlm[20] = (uint8_t)(record->lon >> 8);
+	tlm[21] = (uint8_t)(record->lon >> 16);
+	tlm[22] = (uint8_t)(record->lon >> 24);
+	tlm[23] = (uint8_t)(g_battery_mv);
+	tlm[24] = (uint8_t)(g_battery_mv >> 8);
+	tlm[25] = g_battery_soc;
+	uint16_t crc = crc16(tlm, TLM_RECORD_SIZE - 2);
+	tlm[26] = (uint8_t)(crc);
+	tlm[27] = (uint8_t)(crc >> 8);
+
+	uint8_t len = cobs_encode(tlm, TLM_RECORD_SIZE, frame);
+	frame[len++] = 0x00;
+	Serial.write(frame, len);
+}
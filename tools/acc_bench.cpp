@@ -0,0 +1,145 @@
+/**
+ * @file acc_bench.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host harness for the motion classification
+ *     Feeds a recorded LIS3DH trace through the emulated FIFO into acc_fifo_task(),
+ *     checks the classification against the labels of the trace and that no FIFO
+ *     read exceeds the Wire buffer, then measures the run time of acc_classify().
+ *     Build: make -C tools acc_bench
+ *     Usage: acc_bench traces/acc_motion.csv
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include <chrono>
+
+extern LIS3DH acc_sensor;
+extern uint8_t last_motion_class;
+
+/** Max number of samples in a trace */
+#define TRACE_MAX 10000
+/** Samples per FIFO window, acc_fifo_task runs every 3 s at 10 Hz */
+#define WINDOW_NEW 30
+/** Samples in the FIFO */
+#define WINDOW_SIZE 32
+/** Number of benchmark rounds over all windows */
+#define BENCH_ROUNDS 2000
+
+/** Trace samples in mg */
+int16_t trace[TRACE_MAX][3];
+/** Expected motion class of each sample */
+uint8_t trace_class[TRACE_MAX];
+
+/**
+ * @brief Convert a label of the trace to the motion class
+ *
+ * @param label label text
+ * @return uint8_t motion class
+ */
+static uint8_t label_class(const char *label)
+{
+	if (strncmp(label, "still", 5) == 0)
+	{
+		return MOTION_STILL;
+	}
+	if (strncmp(label, "walk", 4) == 0)
+	{
+		return MOTION_WALKING;
+	}
+	if (strncmp(label, "drive", 5) == 0)
+	{
+		return MOTION_DRIVING;
+	}
+	return MOTION_UNKNOWN;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 2)
+	{
+		fprintf(stderr, "Usage: %s <trace.csv>\n", argv[0]);
+		return 2;
+	}
+	FILE *file = fopen(argv[1], "r");
+	if (file == NULL)
+	{
+		perror(argv[1]);
+		return 2;
+	}
+	uint16_t count = 0;
+	char line[128];
+	while ((count < TRACE_MAX) && (fgets(line, sizeof(line), file) != NULL))
+	{
+		int x, y, z;
+		char label[16];
+		if ((line[0] == '#') || (sscanf(line, "%d,%d,%d,%15s", &x, &y, &z, label) != 4))
+		{
+			continue;
+		}
+		trace[count][0] = x;
+		trace[count][1] = y;
+		trace[count][2] = z;
+		trace_class[count] = label_class(label);
+		count++;
+	}
+	fclose(file);
+	printf("Trace %s: %d samples\n", argv[1], count);
+
+	// Firmware path, FIFO reads and classification like on the device
+	g_has_acc = true;
+	uint16_t windows = 0;
+	uint16_t correct = 0;
+	for (uint16_t idx = 0; idx < count; idx++)
+	{
+		acc_sensor.push_sample(trace[idx][0], trace[idx][1], trace[idx][2]);
+		if (((idx + 1) % WINDOW_NEW) != 0)
+		{
+			continue;
+		}
+		acc_fifo_task();
+		// Only windows with a single label are scored
+		if ((idx + 1 < WINDOW_SIZE) || (trace_class[idx + 1 - WINDOW_SIZE] != trace_class[idx]))
+		{
+			continue;
+		}
+		windows++;
+		if (last_motion_class == trace_class[idx])
+		{
+			correct++;
+		}
+	}
+	printf("Classification: %d of %d windows correct\n", correct, windows);
+	printf("FIFO reads: largest %d bytes, Wire buffer %d bytes, %ld overflows\n",
+		   acc_sensor.largest_read, WIRE_BUFFER_SIZE, Wire.overflows);
+
+	// Benchmark of the classifier over all windows of the trace
+	uint16_t num_windows = count / WINDOW_SIZE;
+	volatile uint8_t result = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (uint16_t round = 0; round < BENCH_ROUNDS; round++)
+	{
+		for (uint16_t window = 0; window < num_windows; window++)
+		{
+			result = acc_classify(&trace[window * WINDOW_SIZE], WINDOW_SIZE);
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+	double ns = std::chrono::duration<double, std::nano>(end - start).count() / ((double)BENCH_ROUNDS * num_windows);
+	printf("acc_classify: %.0f ns per %d sample window (host)\n", ns, WINDOW_SIZE);
+
+	bool failed = false;
+	if ((acc_sensor.largest_read > WIRE_BUFFER_SIZE) || (Wire.overflows != 0))
+	{
+		printf("FAIL: FIFO read does not fit into the Wire buffer\n");
+		failed = true;
+	}
+	if ((windows == 0) || (correct * 10 < windows * 9))
+	{
+		printf("FAIL: less than 90%% of the windows classified correct\n");
+		failed = true;
+	}
+	return failed ? 1 : 0;
+}
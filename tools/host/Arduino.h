@@ -0,0 +1,354 @@
+/**
+ * @file Arduino.h
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, minimal Arduino and RUI3 API
+ *     Time is simulated, delay() advances the clock. Timers, flash and the
+ *     LoRa/LoRaWAN API are emulated in host_env.cpp
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <time.h>
+#include <string>
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+
+// Pins and modes
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+#define WB_IO1 1
+#define WB_IO2 2
+#define WB_IO5 5
+#define LED_GREEN 35
+#define LED_BLUE 36
+#define PIN_WIRE_SDA 13
+#define PIN_WIRE_SCL 14
+
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t value);
+int digitalRead(uint32_t pin);
+void attachInterrupt(uint32_t pin, void (*callback)(void), uint32_t mode);
+void detachInterrupt(uint32_t pin);
+inline void noInterrupts(void) {}
+inline void interrupts(void) {}
+
+// Simulated time
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+
+/** Arduino String, only what the firmware uses */
+class String
+{
+public:
+	String(void) {}
+	String(const char *text) : value(text) {}
+	const char *c_str(void) const { return value.c_str(); }
+	unsigned int length(void) const { return value.length(); }
+	void toUpperCase(void)
+	{
+		for (char &c : value)
+		{
+			c = toupper(c);
+		}
+	}
+
+private:
+	std::string value;
+};
+
+/** Serial port, the output is discarded unless host_serial_echo is set */
+class HardwareSerial
+{
+public:
+	void begin(uint32_t baud) {}
+	int available(void) { return 1; }
+	size_t write(const uint8_t *data, size_t len);
+	size_t write(uint8_t data) { return write(&data, 1); }
+	int printf(const char *format, ...);
+	size_t print(const char *text) { return printf("%s", text); }
+	size_t println(const char *text) { return printf("%s\r\n", text); }
+};
+extern HardwareSerial Serial;
+extern HardwareSerial Serial6;
+extern bool host_serial_echo;
+
+// AT commands
+typedef int SERIAL_PORT;
+/** AT command parameters */
+typedef struct
+{
+	uint32_t argc;
+	char *argv[16];
+} stParam;
+#define AT_OK 0
+#define AT_ERROR 1
+#define AT_PARAM_ERROR 2
+#define AT_BUSY_ERROR 3
+#define RAK_ATCMD_PERM_READ 1
+#define RAK_ATCMD_PERM_WRITE 2
+int atcmd_printf(const char *format, ...);
+int at_check_hex_param(char *hex, uint32_t len, uint8_t *data);
+
+// Timers
+typedef enum
+{
+	RAK_TIMER_0 = 0,
+	RAK_TIMER_1,
+	RAK_TIMER_2,
+	RAK_TIMER_3,
+	RAK_TIMER_4,
+	RAK_TIMER_ID_MAX
+} RAK_TIMER_ID;
+typedef enum
+{
+	RAK_TIMER_ONESHOT = 0,
+	RAK_TIMER_PERIODIC
+} RAK_TIMER_MODE;
+typedef void (*RAK_TIMER_HANDLER)(void *data);
+
+// LoRa
+typedef enum
+{
+	RAK_LORAMAC_STATUS_OK = 0,
+	RAK_LORAMAC_STATUS_ERROR,
+	RAK_LORAMAC_STATUS_TX_TIMEOUT,
+	RAK_LORAMAC_STATUS_RX1_TIMEOUT,
+	RAK_LORAMAC_STATUS_RX2_TIMEOUT,
+	RAK_LORAMAC_STATUS_RX1_ERROR,
+	RAK_LORAMAC_STATUS_RX2_ERROR,
+	RAK_LORAMAC_STATUS_JOIN_FAIL,
+	RAK_LORAMAC_STATUS_DOWNLINK_REPEATED,
+	RAK_LORAMAC_STATUS_TX_DR_PAYLOAD_SIZE_ERROR,
+	RAK_LORAMAC_STATUS_DOWNLINK_TOO_MANY_FRAMES_LOSS,
+	RAK_LORAMAC_STATUS_ADDRESS_FAIL,
+	RAK_LORAMAC_STATUS_MIC_FAIL,
+	RAK_LORAMAC_STATUS_MULTICAST_FAIL,
+	RAK_LORAMAC_STATUS_BEACON_LOCKED,
+	RAK_LORAMAC_STATUS_BEACON_LOST,
+	RAK_LORAMAC_STATUS_BEACON_NOT_FOUND
+} RAK_LORAMAC_STATUS;
+
+/** LoRaWAN RX packet */
+typedef struct
+{
+	uint8_t Port;
+	uint8_t RxDatarate;
+	uint8_t *Buffer;
+	uint8_t BufferSize;
+	int16_t Rssi;
+	int8_t Snr;
+} SERVICE_LORA_RECEIVE_T;
+
+/** LoRaWAN LinkCheck result */
+typedef struct
+{
+	uint8_t State;
+	uint8_t DemodMargin;
+	uint8_t NbGateways;
+	int16_t Rssi;
+	int8_t Snr;
+} SERVICE_LORA_LINKCHECK_T;
+
+/** LoRa P2P RX packet */
+typedef struct
+{
+	uint8_t *Buffer;
+	uint8_t BufferSize;
+	int16_t Rssi;
+	int8_t Snr;
+} rui_lora_p2p_recv_t;
+
+/** Numeric RUI3 setting */
+class HostValue
+{
+public:
+	uint32_t get(void) { return value; }
+	bool get(uint8_t *buf, uint32_t len)
+	{
+		memset(buf, 0, len);
+		return true;
+	}
+	bool set(uint32_t new_value)
+	{
+		value = new_value;
+		return true;
+	}
+	bool set(void)
+	{
+		value = 1;
+		return true;
+	}
+	uint32_t value = 0;
+};
+
+/** Network mode, 0 = LoRa P2P, 1 = LoRaWAN, shared by api.lora and api.lorawan */
+extern uint32_t host_nwm;
+/** Network mode setting, set() without value selects the mode of the API part */
+class HostNwm
+{
+public:
+	HostNwm(uint32_t api_mode) : mode(api_mode) {}
+	uint32_t get(void) { return host_nwm; }
+	bool set(void)
+	{
+		host_nwm = mode;
+		return true;
+	}
+	bool set(uint32_t new_mode)
+	{
+		host_nwm = new_mode;
+		return true;
+	}
+
+private:
+	uint32_t mode;
+};
+
+/** Text RUI3 setting */
+class HostText
+{
+public:
+	String get(void) { return String(text); }
+	bool set(const char *new_text)
+	{
+		snprintf(text, sizeof(text), "%s", new_text);
+		return true;
+	}
+	char text[64] = "rak4630";
+};
+
+/** Battery voltage */
+class HostBattery
+{
+public:
+	float get(void) { return volts; }
+	float volts = 4.0;
+};
+
+/** LoRa P2P API */
+class HostLora
+{
+public:
+	HostNwm nwm = HostNwm(0);
+	HostValue pfreq, psf, pbw, pcr, ptp, ppl, pbr, pfdev;
+	bool precv(uint32_t timeout);
+	bool psend(uint8_t len, uint8_t *data, bool cad = false);
+	bool registerPRecvCallback(void (*callback)(rui_lora_p2p_recv_t)) { recv_cb = callback; return true; }
+	bool registerPSendCallback(void (*callback)(void)) { send_cb = callback; return true; }
+	void (*recv_cb)(rui_lora_p2p_recv_t) = NULL;
+	void (*send_cb)(void) = NULL;
+	uint32_t sends = 0;
+};
+
+/** LoRaWAN API */
+class HostLorawan
+{
+public:
+	HostNwm nwm = HostNwm(1);
+	HostValue band, dr, txp, adr, njs, njm, cfm, linkcheck, deui, appeui, appkey, appskey, nwkskey, daddr;
+	bool join(uint8_t join_start = 1, uint8_t auto_join = 0, uint32_t period = 8, uint8_t attempts = 0);
+	bool send(uint8_t len, uint8_t *data, uint8_t fport, bool confirm = true, uint8_t retry = 0);
+	bool registerRecvCallback(void (*callback)(SERVICE_LORA_RECEIVE_T *)) { recv_cb = callback; return true; }
+	bool registerSendCallback(void (*callback)(int32_t)) { send_cb = callback; return true; }
+	bool registerJoinCallback(void (*callback)(int32_t)) { join_cb = callback; return true; }
+	bool registerLinkCheckCallback(void (*callback)(SERVICE_LORA_LINKCHECK_T *)) { linkcheck_cb = callback; return true; }
+	void (*recv_cb)(SERVICE_LORA_RECEIVE_T *) = NULL;
+	void (*send_cb)(int32_t) = NULL;
+	void (*join_cb)(int32_t) = NULL;
+	void (*linkcheck_cb)(SERVICE_LORA_LINKCHECK_T *) = NULL;
+	uint32_t sends = 0;
+	uint32_t joins = 0;
+};
+
+/** User flash, set() erases and writes every page it touches like RUI3 */
+class HostFlash
+{
+public:
+	bool get(uint32_t offset, uint8_t *buf, uint32_t len);
+	bool set(uint32_t offset, uint8_t *buf, uint32_t len);
+	uint32_t page_erases = 0;
+	uint32_t set_calls = 0;
+};
+
+/** Timers */
+class HostTimer
+{
+public:
+	bool create(RAK_TIMER_ID id, RAK_TIMER_HANDLER handler, RAK_TIMER_MODE mode);
+	bool start(RAK_TIMER_ID id, uint32_t ms, void *data);
+	bool stop(RAK_TIMER_ID id);
+};
+
+/** AT command registration */
+class HostAtMode
+{
+public:
+	bool add(const char *cmd, const char *usage, const char *title, int (*handler)(SERIAL_PORT, char *, stParam *), uint32_t perm = RAK_ATCMD_PERM_READ | RAK_ATCMD_PERM_WRITE);
+};
+
+/** System API */
+class HostSystem
+{
+public:
+	HostFlash flash;
+	HostTimer timer;
+	HostAtMode atMode;
+	HostText hwModel, firmwareVer, firmwareVersion;
+	HostValue lpm;
+	HostBattery bat;
+	void reboot(void) { reboots++; }
+	uint32_t reboots = 0;
+};
+
+/** RUI3 API */
+class HostApi
+{
+public:
+	HostLora lora;
+	HostLorawan lorawan;
+	HostSystem system;
+};
+extern HostApi api;
+
+// Host simulation
+/** Size of the emulated user flash */
+#define HOST_FLASH_SIZE 0x10000
+/** Page size of the emulated user flash */
+#define HOST_FLASH_PAGE 4096
+extern uint8_t host_flash[HOST_FLASH_SIZE];
+/** Flag that a timer callback runs, on the device this is interrupt context */
+extern bool host_in_timer;
+/** Number of framebuffer changes done in a timer callback */
+extern uint32_t host_timer_draws;
+void host_run(uint32_t ms);
+void host_fire_timer(RAK_TIMER_ID id);
+bool host_timer_running(RAK_TIMER_ID id);
+int host_at(const char *cmd);
+
+// The RUI3 Arduino.h includes the I2C bus
+#include "Wire.h"
+
+#endif // _HOST_ARDUINO_H_
@@ -0,0 +1,10 @@
+/**
+ * @file ArduinoJson.h
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, the JSON part of CayenneLPP is not used
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
@@ -0,0 +1,45 @@
+/**
+ * @file CayenneLPP.h
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, buffer part of the CayenneLPP library
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _HOST_CAYENNE_LPP_H_
+#define _HOST_CAYENNE_LPP_H_
+
+#include "Arduino.h"
+
+#define LPP_ERROR_OK 0
+#define LPP_ERROR_OVERFLOW 1
+
+/** Cayenne LPP payload buffer */
+class CayenneLPP
+{
+public:
+	CayenneLPP(uint8_t size) : _maxsize(size)
+	{
+		_buffer = (uint8_t *)malloc(size);
+		_cursor = 0;
+	}
+	~CayenneLPP(void) { free(_buffer); }
+	void reset(void)
+	{
+		_cursor = 0;
+		_error = LPP_ERROR_OK;
+	}
+	uint8_t getSize(void) { return _cursor; }
+	uint8_t *getBuffer(void) { return _buffer; }
+	uint8_t getError(void) { return _error; }
+
+protected:
+	uint8_t *_buffer;
+	uint8_t _maxsize;
+	uint8_t _cursor;
+	uint8_t _error = LPP_ERROR_OK;
+};
+
+#endif // _HOST_CAYENNE_LPP_H_
@@ -0,0 +1,126 @@
+/**
+ * @file SparkFunLIS3DH.h
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, LIS3DH with a FIFO fed by the test
+ *     Only the registers used by acc.cpp are emulated. Reads go through
+ *     the Wire buffer, a read of more than 32 bytes returns only 32 bytes
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _HOST_LIS3DH_H_
+#define _HOST_LIS3DH_H_
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#define I2C_MODE 0
+#define IMU_SUCCESS 0
+#define IMU_HW_ERROR 1
+
+#define LIS3DH_CTRL_REG1 0x20
+#define LIS3DH_CTRL_REG2 0x21
+#define LIS3DH_CTRL_REG3 0x22
+#define LIS3DH_CTRL_REG4 0x23
+#define LIS3DH_CTRL_REG5 0x24
+#define LIS3DH_CTRL_REG6 0x25
+#define LIS3DH_OUT_X_L 0x28
+#define LIS3DH_FIFO_CTRL_REG 0x2E
+#define LIS3DH_FIFO_SRC_REG 0x2F
+#define LIS3DH_INT1_CFG 0x30
+#define LIS3DH_INT1_SRC 0x31
+#define LIS3DH_INT1_THS 0x32
+#define LIS3DH_INT1_DURATION 0x33
+
+/** Number of samples in the FIFO */
+#define LIS3DH_FIFO_SIZE 32
+
+/** Sensor settings */
+struct SensorSettings
+{
+	uint8_t adcEnabled;
+	uint8_t tempEnabled;
+	uint16_t accelSampleRate;
+	uint8_t accelRange;
+	uint8_t xAccelEnabled;
+	uint8_t yAccelEnabled;
+	uint8_t zAccelEnabled;
+};
+
+/** LIS3DH in low power mode, 8 bit samples in the high byte */
+class LIS3DH
+{
+public:
+	LIS3DH(uint8_t mode, uint8_t address) {}
+	uint8_t begin(void) { return IMU_SUCCESS; }
+	uint8_t writeRegister(uint8_t offset, uint8_t data)
+	{
+		registers[offset] = data;
+		return IMU_SUCCESS;
+	}
+	uint8_t readRegister(uint8_t *data, uint8_t offset)
+	{
+		if (offset == LIS3DH_FIFO_SRC_REG)
+		{
+			*data = (fifo_count == LIS3DH_FIFO_SIZE) ? 0x40 : fifo_count;
+		}
+		else
+		{
+			*data = registers[offset];
+		}
+		return IMU_SUCCESS;
+	}
+	uint8_t readRegisterRegion(uint8_t *data, uint8_t offset, uint8_t len)
+	{
+		Wire.beginTransmission(0x18);
+		Wire.write(offset | 0x80);
+		Wire.endTransmission(false);
+		uint8_t received = Wire.requestFrom(0x18, len);
+		largest_read = max(largest_read, (uint16_t)len);
+		// Each sample read from OUT_X_L takes the next sample from the FIFO
+		for (uint8_t idx = 0; idx < received; idx++)
+		{
+			uint8_t axis = (idx % 6) / 2;
+			data[idx] = (idx & 1) ? (uint8_t)(fifo[0][axis] / 16) : 0;
+			if (((idx % 6) == 5) && (fifo_count != 0))
+			{
+				memmove(fifo[0], fifo[1], (LIS3DH_FIFO_SIZE - 1) * sizeof(fifo[0]));
+				fifo_count--;
+			}
+		}
+		return IMU_SUCCESS;
+	}
+
+	/**
+	 * @brief Add a sample to the FIFO, the oldest sample is dropped in stream mode
+	 *
+	 * @param x X acceleration in mg
+	 * @param y Y acceleration in mg
+	 * @param z Z acceleration in mg
+	 */
+	void push_sample(int16_t x, int16_t y, int16_t z)
+	{
+		if (fifo_count == LIS3DH_FIFO_SIZE)
+		{
+			memmove(fifo[0], fifo[1], (LIS3DH_FIFO_SIZE - 1) * sizeof(fifo[0]));
+			fifo_count--;
+		}
+		fifo[fifo_count][0] = x;
+		fifo[fifo_count][1] = y;
+		fifo[fifo_count][2] = z;
+		fifo_count++;
+	}
+
+	SensorSettings settings;
+	/** Largest burst read requested by the firmware */
+	uint16_t largest_read = 0;
+
+private:
+	uint8_t registers[0x40] = {0};
+	int16_t fifo[LIS3DH_FIFO_SIZE][3];
+	uint8_t fifo_count = 0;
+};
+
+#endif // _HOST_LIS3DH_H_
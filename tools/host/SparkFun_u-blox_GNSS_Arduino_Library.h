@@ -0,0 +1,83 @@
+/**
+ * @file SparkFun_u-blox_GNSS_Arduino_Library.h
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, u-blox receiver with a location set by the test
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _HOST_UBLOX_H_
+#define _HOST_UBLOX_H_
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#define COM_TYPE_UBX 0x01
+#define SFE_UBLOX_GNSS_ID_GPS 0
+#define SFE_UBLOX_GNSS_ID_SBAS 1
+#define SFE_UBLOX_GNSS_ID_GALILEO 2
+#define SFE_UBLOX_GNSS_ID_BEIDOU 3
+#define SFE_UBLOX_GNSS_ID_IMES 4
+#define SFE_UBLOX_GNSS_ID_QZSS 5
+#define SFE_UBLOX_GNSS_ID_GLONASS 6
+
+/** u-blox receiver, each poll costs one PVT read on the I2C bus */
+class SFE_UBLOX_GNSS
+{
+public:
+	bool begin(TwoWire &port = Wire) { return present; }
+	bool setI2COutput(uint8_t type) { return true; }
+	bool enableGNSS(bool enable, uint8_t id) { return true; }
+	bool setNavigationFrequency(uint8_t rate) { return true; }
+	bool setAutoPVT(bool enable, bool implicit) { return true; }
+	bool setMeasurementRate(uint16_t rate) { return true; }
+	bool saveConfiguration(void) { return true; }
+	bool powerOff(uint32_t duration) { return true; }
+	bool getGnssFixOk(void)
+	{
+		read_pvt();
+		return fix_type >= 3;
+	}
+	uint8_t getFixType(void)
+	{
+		read_pvt();
+		return fix_type;
+	}
+	uint8_t getSIV(void) { return satellites; }
+	int32_t getLatitude(void) { return latitude; }
+	int32_t getLongitude(void) { return longitude; }
+	int32_t getAltitude(void) { return altitude; }
+	uint16_t getHorizontalDOP(void) { return hdop; }
+
+	/** Receiver found on the bus */
+	bool present = true;
+	/** Fix type, 3 = 3D fix */
+	uint8_t fix_type = 0;
+	/** Satellites in view */
+	uint8_t satellites = 0;
+	/** Latitude in 1e-7 degrees */
+	int32_t latitude = 0;
+	/** Longitude in 1e-7 degrees */
+	int32_t longitude = 0;
+	/** Altitude in mm */
+	int32_t altitude = 0;
+	/** HDOP in 0.01 */
+	uint16_t hdop = 9999;
+	/** Number of location polls */
+	uint32_t polls = 0;
+
+private:
+	/** Read the UBX-NAV-PVT message */
+	void read_pvt(void)
+	{
+		Wire.beginTransmission(0x42);
+		Wire.write(0xFD);
+		Wire.endTransmission(false);
+		Wire.requestFrom(0x42, 32);
+		polls++;
+	}
+};
+
+#endif // _HOST_UBLOX_H_
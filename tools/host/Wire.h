@@ -0,0 +1,77 @@
+/**
+ * @file Wire.h
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, I2C bus that counts the transfers
+ *     Like the Arduino Wire library a transfer can hold max 32 bytes,
+ *     more bytes are dropped and counted as overflow
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _HOST_WIRE_H_
+#define _HOST_WIRE_H_
+
+#include "Arduino.h"
+
+/** Size of the Wire TX and RX buffer */
+#define WIRE_BUFFER_SIZE 32
+
+/** I2C bus */
+class TwoWire
+{
+public:
+	void begin(void) {}
+	void setClock(uint32_t clock) {}
+	void beginTransmission(uint8_t address)
+	{
+		tx_len = 0;
+		bytes++; // Address byte
+	}
+	size_t write(uint8_t data)
+	{
+		if (tx_len == WIRE_BUFFER_SIZE)
+		{
+			overflows++;
+			return 0;
+		}
+		tx_len++;
+		bytes++;
+		return 1;
+	}
+	uint8_t endTransmission(bool stop = true)
+	{
+		transfers++;
+		timer_transfers += host_in_timer ? 1 : 0;
+		return 0;
+	}
+	uint8_t requestFrom(uint8_t address, size_t len)
+	{
+		transfers++;
+		timer_transfers += host_in_timer ? 1 : 0;
+		if (len > WIRE_BUFFER_SIZE)
+		{
+			overflows++;
+			len = WIRE_BUFFER_SIZE;
+		}
+		bytes += len + 1;
+		return len;
+	}
+
+	/** Number of I2C transfers */
+	uint32_t transfers = 0;
+	/** Number of bytes on the bus, including the address bytes */
+	uint32_t bytes = 0;
+	/** Number of transfers that did not fit into the Wire buffer */
+	uint32_t overflows = 0;
+	/** Number of transfers started from a timer callback */
+	uint32_t timer_transfers = 0;
+
+private:
+	/** Bytes in the current transfer */
+	uint8_t tx_len = 0;
+};
+extern TwoWire Wire;
+
+#endif // _HOST_WIRE_H_
@@ -0,0 +1,319 @@
+/**
+ * @file host_env.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, simulated clock, timers, flash and radio
+ *     host_run() advances the clock in 1 ms steps, fires the due timers and
+ *     calls loop() like the RUI3 scheduler does
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Arduino.h"
+#include "Wire.h"
+
+void loop(void);
+
+HostApi api;
+HardwareSerial Serial;
+HardwareSerial Serial6;
+TwoWire Wire;
+
+/** Flag to print the serial output of the firmware */
+bool host_serial_echo = false;
+/** Emulated user flash */
+uint8_t host_flash[HOST_FLASH_SIZE];
+/** Simulated time in us */
+uint64_t host_time_us = 0;
+/** Output state of the pins */
+uint8_t host_pins[64];
+/** Network mode */
+uint32_t host_nwm = 1;
+/** Number of requests to enter the DFU mode */
+uint32_t host_dfu_requests = 0;
+/** Flag that a timer callback runs */
+bool host_in_timer = false;
+
+/** Emulated timer */
+struct host_timer_s
+{
+	RAK_TIMER_HANDLER handler; // Timer callback
+	RAK_TIMER_MODE mode;	   // One shot or periodic
+	bool running;			   // Timer is started
+	uint32_t period;		   // Timer period in ms
+	uint64_t due;			   // Time of the next callback in us
+	void *data;				   // Callback data
+};
+/** Emulated timers */
+host_timer_s host_timers[RAK_TIMER_ID_MAX];
+
+/** Registered AT command */
+struct host_at_s
+{
+	const char *cmd;										 // Command name without ATC+
+	int (*handler)(SERIAL_PORT port, char *cmd, stParam *param); // Handler
+};
+/** Registered AT commands */
+host_at_s host_at_cmds[32];
+/** Number of registered AT commands */
+uint8_t host_at_count = 0;
+
+/**
+ * @brief Fill the flash with the erased value on start
+ *
+ */
+static struct host_flash_init_s
+{
+	host_flash_init_s(void) { memset(host_flash, 0xFF, sizeof(host_flash)); }
+} host_flash_init;
+
+uint32_t millis(void)
+{
+	return (uint32_t)(host_time_us / 1000);
+}
+
+uint32_t micros(void)
+{
+	return (uint32_t)host_time_us;
+}
+
+void delay(uint32_t ms)
+{
+	host_time_us += (uint64_t)ms * 1000;
+}
+
+void pinMode(uint32_t pin, uint32_t mode) {}
+
+void digitalWrite(uint32_t pin, uint32_t value)
+{
+	host_pins[pin % 64] = value;
+}
+
+int digitalRead(uint32_t pin)
+{
+	return host_pins[pin % 64];
+}
+
+void attachInterrupt(uint32_t pin, void (*callback)(void), uint32_t mode) {}
+
+void detachInterrupt(uint32_t pin) {}
+
+size_t HardwareSerial::write(const uint8_t *data, size_t len)
+{
+	if (host_serial_echo)
+	{
+		fwrite(data, 1, len, stdout);
+	}
+	return len;
+}
+
+int HardwareSerial::printf(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int len = host_serial_echo ? vprintf(format, args) : vsnprintf(NULL, 0, format, args);
+	va_end(args);
+	return len;
+}
+
+int atcmd_printf(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int len = host_serial_echo ? vprintf(format, args) : vsnprintf(NULL, 0, format, args);
+	va_end(args);
+	return len;
+}
+
+int at_check_hex_param(char *hex, uint32_t len, uint8_t *data)
+{
+	if ((len % 2) != 0)
+	{
+		return -1;
+	}
+	for (uint32_t idx = 0; idx < len; idx += 2)
+	{
+		char byte[3] = {hex[idx], hex[idx + 1], 0};
+		if (!isxdigit(byte[0]) || !isxdigit(byte[1]))
+		{
+			return -1;
+		}
+		data[idx / 2] = strtoul(byte, NULL, 16);
+	}
+	return 0;
+}
+
+bool HostLora::precv(uint32_t timeout)
+{
+	return true;
+}
+
+bool HostLora::psend(uint8_t len, uint8_t *data, bool cad)
+{
+	sends++;
+	return true;
+}
+
+bool HostLorawan::join(uint8_t join_start, uint8_t auto_join, uint32_t period, uint8_t attempts)
+{
+	joins++;
+	return true;
+}
+
+bool HostLorawan::send(uint8_t len, uint8_t *data, uint8_t fport, bool confirm, uint8_t retry)
+{
+	sends++;
+	return true;
+}
+
+bool HostFlash::get(uint32_t offset, uint8_t *buf, uint32_t len)
+{
+	if ((offset + len) > HOST_FLASH_SIZE)
+	{
+		return false;
+	}
+	memcpy(buf, &host_flash[offset], len);
+	return true;
+}
+
+bool HostFlash::set(uint32_t offset, uint8_t *buf, uint32_t len)
+{
+	if ((len == 0) || ((offset + len) > HOST_FLASH_SIZE))
+	{
+		return false;
+	}
+	set_calls++;
+	// Every touched page is read, erased and written again
+	page_erases += (offset + len - 1) / HOST_FLASH_PAGE - offset / HOST_FLASH_PAGE + 1;
+	memcpy(&host_flash[offset], buf, len);
+	return true;
+}
+
+bool HostTimer::create(RAK_TIMER_ID id, RAK_TIMER_HANDLER handler, RAK_TIMER_MODE mode)
+{
+	host_timers[id].handler = handler;
+	host_timers[id].mode = mode;
+	host_timers[id].running = false;
+	return true;
+}
+
+bool HostTimer::start(RAK_TIMER_ID id, uint32_t ms, void *data)
+{
+	host_timers[id].period = ms;
+	host_timers[id].due = host_time_us + (uint64_t)ms * 1000;
+	host_timers[id].data = data;
+	host_timers[id].running = true;
+	return true;
+}
+
+bool HostTimer::stop(RAK_TIMER_ID id)
+{
+	host_timers[id].running = false;
+	return true;
+}
+
+bool HostAtMode::add(const char *cmd, const char *usage, const char *title, int (*handler)(SERIAL_PORT, char *, stParam *), uint32_t perm)
+{
+	if (host_at_count == sizeof(host_at_cmds) / sizeof(host_at_cmds[0]))
+	{
+		return false;
+	}
+	host_at_cmds[host_at_count].cmd = cmd;
+	host_at_cmds[host_at_count].handler = handler;
+	host_at_count++;
+	return true;
+}
+
+/**
+ * @brief Call a timer callback like the timer expired
+ *
+ * @param id timer
+ */
+void host_fire_timer(RAK_TIMER_ID id)
+{
+	host_timer_s *timer = &host_timers[id];
+	if (timer->mode == RAK_TIMER_PERIODIC)
+	{
+		timer->due += (uint64_t)timer->period * 1000;
+	}
+	else
+	{
+		timer->running = false;
+	}
+	if (timer->handler != NULL)
+	{
+		host_in_timer = true;
+		timer->handler(timer->data);
+		host_in_timer = false;
+	}
+}
+
+/**
+ * @brief Check if a timer is started
+ *
+ * @param id timer
+ * @return true if the timer is running
+ */
+bool host_timer_running(RAK_TIMER_ID id)
+{
+	return host_timers[id].running;
+}
+
+/**
+ * @brief Run the firmware for some time
+ *     The clock advances in 1 ms steps, due timers are fired
+ *     and loop() is called once per step
+ *
+ * @param ms simulated time in ms
+ */
+void host_run(uint32_t ms)
+{
+	uint64_t end = host_time_us + (uint64_t)ms * 1000;
+	while (host_time_us < end)
+	{
+		host_time_us += 1000;
+		for (uint8_t id = 0; id < RAK_TIMER_ID_MAX; id++)
+		{
+			if (host_timers[id].running && (host_timers[id].due <= host_time_us))
+			{
+				host_fire_timer((RAK_TIMER_ID)id);
+			}
+		}
+		loop();
+	}
+}
+
+/**
+ * @brief Run a custom AT command
+ *
+ * @param cmd command like ATC+STATS=? or ATC+PROF=SAVE,1,Test
+ * @return int result of the AT handler, -1 if the command is unknown
+ */
+int host_at(const char *cmd)
+{
+	char line[256];
+	snprintf(line, sizeof(line), "%s", cmd);
+	char *name = strncmp(line, "ATC+", 4) == 0 ? line + 4 : line;
+	stParam param;
+	param.argc = 0;
+	char *args = strchr(name, '=');
+	if (args != NULL)
+	{
+		*args++ = 0;
+		for (char *arg = strtok(args, ","); (arg != NULL) && (param.argc < 16); arg = strtok(NULL, ","))
+		{
+			param.argv[param.argc++] = arg;
+		}
+	}
+	for (uint8_t idx = 0; idx < host_at_count; idx++)
+	{
+		if (strcmp(host_at_cmds[idx].cmd, name) == 0)
+		{
+			char full_cmd[64];
+			snprintf(full_cmd, sizeof(full_cmd), "ATC+%s", name);
+			return host_at_cmds[idx].handler(0, full_cmd, &param);
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file nRF_SSD1306Wire.h
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, SSD1306 emulator with an in-memory framebuffer
+ *     Same framebuffer layout as the ThingPulse library (128 columns x 8 pages,
+ *     LSB = top pixel). Text uses a fixed 5x7 font with 6 pixel advance instead
+ *     of ArialMT, the golden images check the layout, not the glyphs.
+ *     display() sends the framebuffer over the emulated Wire bus like the
+ *     library, commands first, then data in 16 byte chunks.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _HOST_SSD1306WIRE_H_
+#define _HOST_SSD1306WIRE_H_
+
+#include "Arduino.h"
+#include "Wire.h"
+
+/** Display geometry */
+enum OLEDDISPLAY_GEOMETRY
+{
+	GEOMETRY_128_64 = 0,
+	GEOMETRY_128_32
+};
+
+/** Drawing color */
+enum OLEDDISPLAY_COLOR
+{
+	BLACK = 0,
+	WHITE = 1,
+	INVERSE = 2
+};
+
+/** Text alignment */
+enum OLEDDISPLAY_TEXT_ALIGNMENT
+{
+	TEXT_ALIGN_LEFT = 0,
+	TEXT_ALIGN_RIGHT = 1,
+	TEXT_ALIGN_CENTER = 2,
+	TEXT_ALIGN_CENTER_BOTH = 3
+};
+
+/** Font data, only used as font id by the emulator */
+extern const uint8_t ArialMT_Plain_10[];
+
+/** SSD1306 on the I2C bus */
+class SSD1306Wire
+{
+public:
+	SSD1306Wire(uint8_t address, int sda, int scl, OLEDDISPLAY_GEOMETRY geometry, TwoWire *wire);
+	virtual ~SSD1306Wire(void) {}
+
+	bool init(void);
+	void setI2cAutoInit(bool auto_init) {}
+	void displayOn(void);
+	void displayOff(void);
+	void setBrightness(uint8_t brightness) { send_command(0x81); }
+	void setContrast(uint8_t contrast, uint8_t precharge, uint8_t comdetect) { send_command(0x81); }
+	void flipScreenVertically(void) { send_command(0xC8); }
+	virtual void display(void);
+	void clear(void);
+
+	void setColor(OLEDDISPLAY_COLOR new_color) { color = new_color; }
+	void setFont(const uint8_t *new_font) {}
+	void setTextAlignment(OLEDDISPLAY_TEXT_ALIGNMENT alignment) { text_alignment = alignment; }
+	void setPixel(int16_t x, int16_t y);
+	void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+	void drawRect(int16_t x, int16_t y, int16_t width, int16_t height);
+	void fillRect(int16_t x, int16_t y, int16_t width, int16_t height);
+	void drawString(int16_t x, int16_t y, const String &text);
+	uint16_t getStringWidth(const char *text, uint16_t length);
+
+	/** Flag if the display is on */
+	bool display_on = false;
+
+protected:
+	void send_command(uint8_t command);
+
+	/** Framebuffer, 8 pages of 128 columns */
+	uint8_t *buffer;
+
+private:
+	uint8_t frame[128 * 8];
+	OLEDDISPLAY_COLOR color = WHITE;
+	OLEDDISPLAY_TEXT_ALIGNMENT text_alignment = TEXT_ALIGN_LEFT;
+};
+
+#endif // _HOST_SSD1306WIRE_H_
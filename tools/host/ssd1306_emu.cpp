@@ -0,0 +1,374 @@
+/**
+ * @file ssd1306_emu.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, SSD1306 emulator
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "nRF_SSD1306Wire.h"
+
+/** Font id for the firmware */
+const uint8_t ArialMT_Plain_10[] = {0};
+
+/** Number of framebuffer changes done in a timer callback */
+uint32_t host_timer_draws = 0;
+
+/** 5x7 font for ASCII 0x20 to 0x7E, one byte per column, LSB = top */
+static const uint8_t font_5x7[95][5] = {
+	{0x00, 0x00, 0x00, 0x00, 0x00}, // space
+	{0x00, 0x00, 0x5F, 0x00, 0x00}, // !
+	{0x00, 0x07, 0x00, 0x07, 0x00}, // "
+	{0x14, 0x7F, 0x14, 0x7F, 0x14}, // #
+	{0x24, 0x2A, 0x7F, 0x2A, 0x12}, // $
+	{0x23, 0x13, 0x08, 0x64, 0x62}, // %
+	{0x36, 0x49, 0x56, 0x20, 0x50}, // &
+	{0x00, 0x05, 0x03, 0x00, 0x00}, // '
+	{0x00, 0x1C, 0x22, 0x41, 0x00}, // (
+	{0x00, 0x41, 0x22, 0x1C, 0x00}, // )
+	{0x14, 0x08, 0x3E, 0x08, 0x14}, // *
+	{0x08, 0x08, 0x3E, 0x08, 0x08}, // +
+	{0x00, 0x50, 0x30, 0x00, 0x00}, // ,
+	{0x08, 0x08, 0x08, 0x08, 0x08}, // -
+	{0x00, 0x60, 0x60, 0x00, 0x00}, // .
+	{0x20, 0x10, 0x08, 0x04, 0x02}, // /
+	{0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+	{0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+	{0x42, 0x61, 0x51, 0x49, 0x46}, // 2
+	{0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
+	{0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+	{0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+	{0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+	{0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+	{0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+	{0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+	{0x00, 0x36, 0x36, 0x00, 0x00}, // :
+	{0x00, 0x56, 0x36, 0x00, 0x00}, // ;
+	{0x08, 0x14, 0x22, 0x41, 0x00}, // <
+	{0x14, 0x14, 0x14, 0x14, 0x14}, // =
+	{0x00, 0x41, 0x22, 0x14, 0x08}, // >
+	{0x02, 0x01, 0x51, 0x09, 0x06}, // ?
+	{0x32, 0x49, 0x79, 0x41, 0x3E}, // @
+	{0x7E, 0x11, 0x11, 0x11, 0x7E}, // A
+	{0x7F, 0x49, 0x49, 0x49, 0x36}, // B
+	{0x3E, 0x41, 0x41, 0x41, 0x22}, // C
+	{0x7F, 0x41, 0x41, 0x22, 0x1C}, // D
+	{0x7F, 0x49, 0x49, 0x49, 0x41}, // E
+	{0x7F, 0x09, 0x09, 0x09, 0x01}, // F
+	{0x3E, 0x41, 0x49, 0x49, 0x7A}, // G
+	{0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
+	{0x00, 0x41, 0x7F, 0x41, 0x00}, // I
+	{0x20, 0x40, 0x41, 0x3F, 0x01}, // J
+	{0x7F, 0x08, 0x14, 0x22, 0x41}, // K
+	{0x7F, 0x40, 0x40, 0x40, 0x40}, // L
+	{0x7F, 0x02, 0x0C, 0x02, 0x7F}, // M
+	{0x7F, 0x04, 0x08, 0x10, 0x7F}, // N
+	{0x3E, 0x41, 0x41, 0x41, 0x3E}, // O
+	{0x7F, 0x09, 0x09, 0x09, 0x06}, // P
+	{0x3E, 0x41, 0x51, 0x21, 0x5E}, // Q
+	{0x7F, 0x09, 0x19, 0x29, 0x46}, // R
+	{0x46, 0x49, 0x49, 0x49, 0x31}, // S
+	{0x01, 0x01, 0x7F, 0x01, 0x01}, // T
+	{0x3F, 0x40, 0x40, 0x40, 0x3F}, // U
+	{0x1F, 0x20, 0x40, 0x20, 0x1F}, // V
+	{0x3F, 0x40, 0x38, 0x40, 0x3F}, // W
+	{0x63, 0x14, 0x08, 0x14, 0x63}, // X
+	{0x07, 0x08, 0x70, 0x08, 0x07}, // Y
+	{0x61, 0x51, 0x49, 0x45, 0x43}, // Z
+	{0x00, 0x7F, 0x41, 0x41, 0x00}, // [
+	{0x02, 0x04, 0x08, 0x10, 0x20}, // backslash
+	{0x00, 0x41, 0x41, 0x7F, 0x00}, // ]
+	{0x04, 0x02, 0x01, 0x02, 0x04}, // ^
+	{0x40, 0x40, 0x40, 0x40, 0x40}, // _
+	{0x00, 0x01, 0x02, 0x04, 0x00}, // `
+	{0x20, 0x54, 0x54, 0x54, 0x78}, // a
+	{0x7F, 0x48, 0x44, 0x44, 0x38}, // b
+	{0x38, 0x44, 0x44, 0x44, 0x20}, // c
+	{0x38, 0x44, 0x44, 0x48, 0x7F}, // d
+	{0x38, 0x54, 0x54, 0x54, 0x18}, // e
+	{0x08, 0x7E, 0x09, 0x01, 0x02}, // f
+	{0x0C, 0x52, 0x52, 0x52, 0x3E}, // g
+	{0x7F, 0x08, 0x04, 0x04, 0x78}, // h
+	{0x00, 0x44, 0x7D, 0x40, 0x00}, // i
+	{0x20, 0x40, 0x44, 0x3D, 0x00}, // j
+	{0x7F, 0x10, 0x28, 0x44, 0x00}, // k
+	{0x00, 0x41, 0x7F, 0x40, 0x00}, // l
+	{0x7C, 0x04, 0x18, 0x04, 0x78}, // m
+	{0x7C, 0x08, 0x04, 0x04, 0x78}, // n
+	{0x38, 0x44, 0x44, 0x44, 0x38}, // o
+	{0x7C, 0x14, 0x14, 0x14, 0x08}, // p
+	{0x08, 0x14, 0x14, 0x18, 0x7C}, // q
+	{0x7C, 0x08, 0x04, 0x04, 0x08}, // r
+	{0x48, 0x54, 0x54, 0x54, 0x20}, // s
+	{0x04, 0x3F, 0x44, 0x40, 0x20}, // t
+	{0x3C, 0x40, 0x40, 0x20, 0x7C}, // u
+	{0x1C, 0x20, 0x40, 0x20, 0x1C}, // v
+	{0x3C, 0x40, 0x30, 0x40, 0x3C}, // w
+	{0x44, 0x28, 0x10, 0x28, 0x44}, // x
+	{0x0C, 0x50, 0x50, 0x50, 0x3C}, // y
+	{0x44, 0x64, 0x54, 0x4C, 0x44}, // z
+	{0x00, 0x08, 0x36, 0x41, 0x00}, // {
+	{0x00, 0x00, 0x7F, 0x00, 0x00}, // |
+	{0x00, 0x41, 0x36, 0x08, 0x00}, // }
+	{0x02, 0x01, 0x02, 0x04, 0x02}, // ~
+};
+
+/** Horizontal advance of a character */
+#define FONT_ADVANCE 6
+/** Offset of the glyph top from the text position, ArialMT has 2 empty rows on top */
+#define FONT_TOP 2
+/** Line height for multi line text */
+#define FONT_LINE_HEIGHT 13
+
+SSD1306Wire::SSD1306Wire(uint8_t address, int sda, int scl, OLEDDISPLAY_GEOMETRY geometry, TwoWire *wire)
+{
+	buffer = frame;
+	memset(frame, 0, sizeof(frame));
+}
+
+/**
+ * @brief Send one command byte
+ *
+ * @param command command
+ */
+void SSD1306Wire::send_command(uint8_t command)
+{
+	Wire.beginTransmission(0x3C);
+	Wire.write(0x80);
+	Wire.write(command);
+	Wire.endTransmission();
+}
+
+/**
+ * @brief Initialize the display
+ *
+ * @return true always
+ */
+bool SSD1306Wire::init(void)
+{
+	// Same number of commands as the library initialization
+	for (uint8_t idx = 0; idx < 25; idx++)
+	{
+		send_command(0xAE);
+	}
+	clear();
+	return true;
+}
+
+/**
+ * @brief Switch the display on
+ *
+ */
+void SSD1306Wire::displayOn(void)
+{
+	send_command(0xAF);
+	display_on = true;
+}
+
+/**
+ * @brief Switch the display off
+ *
+ */
+void SSD1306Wire::displayOff(void)
+{
+	send_command(0xAE);
+	display_on = false;
+}
+
+/**
+ * @brief Send the complete framebuffer
+ *
+ */
+void SSD1306Wire::display(void)
+{
+	send_command(0x21);
+	send_command(0);
+	send_command(127);
+	send_command(0x22);
+	send_command(0);
+	send_command(7);
+	for (uint16_t idx = 0; idx < sizeof(frame); idx += 16)
+	{
+		Wire.beginTransmission(0x3C);
+		Wire.write(0x40);
+		for (uint8_t col = 0; col < 16; col++)
+		{
+			Wire.write(frame[idx + col]);
+		}
+		Wire.endTransmission();
+	}
+}
+
+/**
+ * @brief Clear the framebuffer
+ *
+ */
+void SSD1306Wire::clear(void)
+{
+	host_timer_draws += host_in_timer ? 1 : 0;
+	memset(frame, 0, sizeof(frame));
+}
+
+/**
+ * @brief Set a pixel in the current color
+ *
+ * @param x column
+ * @param y row
+ */
+void SSD1306Wire::setPixel(int16_t x, int16_t y)
+{
+	host_timer_draws += host_in_timer ? 1 : 0;
+	if ((x < 0) || (x >= 128) || (y < 0) || (y >= 64))
+	{
+		return;
+	}
+	uint8_t *data = &frame[(y / 8) * 128 + x];
+	switch (color)
+	{
+	case WHITE:
+		*data |= 1 << (y & 7);
+		break;
+	case BLACK:
+		*data &= ~(1 << (y & 7));
+		break;
+	case INVERSE:
+		*data ^= 1 << (y & 7);
+		break;
+	}
+}
+
+/**
+ * @brief Draw a line (Bresenham)
+ *
+ * @param x0 start column
+ * @param y0 start row
+ * @param x1 end column
+ * @param y1 end row
+ */
+void SSD1306Wire::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	int16_t dx = abs(x1 - x0);
+	int16_t dy = -abs(y1 - y0);
+	int16_t sx = x0 < x1 ? 1 : -1;
+	int16_t sy = y0 < y1 ? 1 : -1;
+	int16_t err = dx + dy;
+	while (true)
+	{
+		setPixel(x0, y0);
+		if ((x0 == x1) && (y0 == y1))
+		{
+			break;
+		}
+		int16_t err2 = 2 * err;
+		if (err2 >= dy)
+		{
+			err += dy;
+			x0 += sx;
+		}
+		if (err2 <= dx)
+		{
+			err += dx;
+			y0 += sy;
+		}
+	}
+}
+
+/**
+ * @brief Draw the outline of a rectangle
+ *
+ * @param x left column
+ * @param y top row
+ * @param width width
+ * @param height height
+ */
+void SSD1306Wire::drawRect(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+	drawLine(x, y, x + width - 1, y);
+	drawLine(x, y + height - 1, x + width - 1, y + height - 1);
+	drawLine(x, y, x, y + height - 1);
+	drawLine(x + width - 1, y, x + width - 1, y + height - 1);
+}
+
+/**
+ * @brief Fill a rectangle
+ *
+ * @param x left column
+ * @param y top row
+ * @param width width
+ * @param height height
+ */
+void SSD1306Wire::fillRect(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+	for (int16_t row = y; row < y + height; row++)
+	{
+		for (int16_t col = x; col < x + width; col++)
+		{
+			setPixel(col, row);
+		}
+	}
+}
+
+/**
+ * @brief Get the width of a text
+ *
+ * @param text text
+ * @param length number of characters
+ * @return uint16_t width in pixel
+ */
+uint16_t SSD1306Wire::getStringWidth(const char *text, uint16_t length)
+{
+	return length * FONT_ADVANCE;
+}
+
+/**
+ * @brief Draw a text, a new line starts a new text line
+ *
+ * @param x column, depends on the text alignment
+ * @param y top row
+ * @param text text
+ */
+void SSD1306Wire::drawString(int16_t x, int16_t y, const String &text)
+{
+	const char *line = text.c_str();
+	while (*line != 0)
+	{
+		const char *end = strchr(line, '\n');
+		uint16_t len = (end != NULL) ? end - line : strlen(line);
+		int16_t x_pos = x;
+		if (text_alignment == TEXT_ALIGN_RIGHT)
+		{
+			x_pos -= getStringWidth(line, len);
+		}
+		else if ((text_alignment == TEXT_ALIGN_CENTER) || (text_alignment == TEXT_ALIGN_CENTER_BOTH))
+		{
+			x_pos -= getStringWidth(line, len) / 2;
+		}
+		for (uint16_t idx = 0; idx < len; idx++, x_pos += FONT_ADVANCE)
+		{
+			uint8_t c = line[idx];
+			if ((c < 0x20) || (c > 0x7E))
+			{
+				c = '?';
+			}
+			for (uint8_t col = 0; col < 5; col++)
+			{
+				uint8_t bits = font_5x7[c - 0x20][col];
+				for (uint8_t row = 0; row < 7; row++)
+				{
+					if (bits & (1 << row))
+					{
+						setPixel(x_pos + col, y + FONT_TOP + row);
+					}
+				}
+			}
+		}
+		if (end == NULL)
+		{
+			break;
+		}
+		line = end + 1;
+		y += FONT_LINE_HEIGHT;
+	}
+}
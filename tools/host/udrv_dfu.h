@@ -0,0 +1,22 @@
+/**
+ * @file udrv_dfu.h
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host build of the firmware, DFU mode of RUI3
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _HOST_UDRV_DFU_H_
+#define _HOST_UDRV_DFU_H_
+
+/** Number of requests to enter the DFU mode */
+extern uint32_t host_dfu_requests;
+
+inline void udrv_enter_dfu(void)
+{
+	host_dfu_requests++;
+}
+
+#endif // _HOST_UDRV_DFU_H_
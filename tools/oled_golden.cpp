@@ -0,0 +1,255 @@
+/**
+ * @file oled_golden.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host harness for the display layouts
+ *     Draws every menu of the settings UI and every handle_display() screen into
+ *     the SSD1306 emulator and compares the framebuffer with the golden images
+ *     in tools/golden (PBM, P1). Then measures the render time of each screen
+ *     and prints the I2C bytes of the display update.
+ *     Build: make -C tools oled_golden
+ *     Usage: oled_golden golden          compare with the golden images
+ *            oled_golden golden update   write new golden images
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include <chrono>
+
+void setup(void);
+extern SFE_UBLOX_GNSS my_gnss;
+extern uint8_t display_reason;
+extern uint8_t field_tester_pckg[32];
+extern volatile uint8_t link_check_state;
+
+/** Number of benchmark rounds per screen */
+#define BENCH_ROUNDS 200
+/** Size of a PBM image, header plus 64 rows of 128 pixels */
+#define PBM_SIZE (16 + 64 * 129)
+
+/** Screen of the test */
+struct screen_s
+{
+	const char *name; // Name of the golden image
+	uint8_t menu;	  // Menu to show, S_SUB_NONE for a display reason
+	uint8_t reason;	  // Display reason for handle_display()
+	uint8_t state;	  // LinkCheck state for reason 4
+};
+
+/** All menus and all display reasons */
+const screen_s screens[] = {
+	{"menu_top", T_TOP_MENU, 0, 0},
+	{"menu_info", T_INFO_MENU, 0, 0},
+	{"menu_settings", T_SETT_MENU, 0, 0},
+	{"menu_mode", T_MODE_MENU, 0, 0},
+	{"menu_lorawan", T_LORAWAN_MENU, 0, 0},
+	{"menu_lorap2p", T_LORAP2P_MENU, 0, 0},
+	{"menu_profiles", T_PROF_MENU, 0, 0},
+	{"value_send_int", S_SEND_INT, 0, 0},
+	{"value_lpw_band", S_LPW_BAND, 0, 0},
+	{"value_lpw_adr", S_LPW_ADR, 0, 0},
+	{"value_lpw_dr", S_LPW_DR, 0, 0},
+	{"value_lpw_tx", S_LPW_TX, 0, 0},
+	{"value_p2p_freq", S_P2P_FREQ, 0, 0},
+	{"value_p2p_sf", S_P2P_SF, 0, 0},
+	{"value_p2p_bw", S_P2P_BW, 0, 0},
+	{"value_p2p_cr", S_P2P_CR, 0, 0},
+	{"value_p2p_tx", S_P2P_TX, 0, 0},
+	{"reason_1_rx", S_SUB_NONE, 1, 0},
+	{"reason_3_join_failed", S_SUB_NONE, 3, 0},
+	{"reason_4_linkcheck_ok", S_SUB_NONE, 4, 0},
+	{"reason_4_linkcheck_nok", S_SUB_NONE, 4, 1},
+	{"reason_5_joined", S_SUB_NONE, 5, 0},
+	{"reason_6_ft_downlink", S_SUB_NONE, 6, 0},
+	{"reason_7_ft_no_downlink", S_SUB_NONE, 7, 0},
+	{"reason_8_p2p_tx", S_SUB_NONE, 8, 0},
+};
+/** Number of screens */
+#define NUM_SCREENS (sizeof(screens) / sizeof(screens[0]))
+
+/**
+ * @brief Draw a screen into the framebuffer and send it to the display
+ *
+ * @param screen screen to draw
+ */
+static void draw_screen(const screen_s *screen)
+{
+	if (screen->menu != S_SUB_NONE)
+	{
+		g_settings_ui = true;
+		menu_show(screen->menu);
+		return;
+	}
+	g_settings_ui = false;
+	display_reason = screen->reason;
+	link_check_state = screen->state;
+	handle_display(&display_reason);
+	oled_flush();
+}
+
+/**
+ * @brief Get the framebuffer as PBM image
+ *
+ * @param image buffer for the image, PBM_SIZE bytes
+ * @return size_t length of the image
+ */
+static size_t get_pbm(char *image)
+{
+	size_t len = sprintf(image, "P1\n128 64\n");
+	for (uint8_t row = 0; row < 64; row++)
+	{
+		oled_get_row(row, &image[len]);
+		len += 128;
+		image[len++] = '\n';
+	}
+	image[len] = 0;
+	return len;
+}
+
+int main(int argc, char **argv)
+{
+	if ((argc < 2) || (argc > 3))
+	{
+		fprintf(stderr, "Usage: %s <golden dir> [update]\n", argv[0]);
+		return 2;
+	}
+	bool update = (argc == 3) && (strcmp(argv[2], "update") == 0);
+
+	// Fixed device state, the images must not depend on the run
+	my_gnss.present = true;
+	setup();
+	host_run(1000);
+	api.lora.pfreq.set(916100000);
+	api.lora.psf.set(7);
+	api.lora.pbw.set(0);
+	api.lora.pcr.set(1);
+	g_last_settings = g_custom_parameters;
+	ui_last_band = 10;
+	ui_last_dr = 3;
+	ui_last_adr = 1;
+	ui_last_tx = 0;
+	ui_p2p_freq = 916100000;
+	ui_p2p_sf = 7;
+	ui_p2p_bw = 0;
+	ui_p2p_cr = 1;
+	ui_p2p_tx = 22;
+	last_rssi = -87;
+	last_snr = 6;
+	link_check_demod_margin = 12;
+	link_check_gateways = 2;
+	uint8_t downlink[6] = {1, 110, 130, 2, 8, 2};
+	memcpy(field_tester_pckg, downlink, sizeof(downlink));
+
+	// Golden images
+	static char image[PBM_SIZE];
+	static char golden[PBM_SIZE];
+	uint16_t failed = 0;
+	for (uint8_t idx = 0; idx < NUM_SCREENS; idx++)
+	{
+		draw_screen(&screens[idx]);
+		size_t len = get_pbm(image);
+		char path[256];
+		snprintf(path, sizeof(path), "%s/%s.pbm", argv[1], screens[idx].name);
+		if (update)
+		{
+			FILE *file = fopen(path, "w");
+			if ((file == NULL) || (fwrite(image, 1, len, file) != len))
+			{
+				perror(path);
+				return 2;
+			}
+			fclose(file);
+			continue;
+		}
+		FILE *file = fopen(path, "r");
+		size_t golden_len = 0;
+		if (file != NULL)
+		{
+			golden_len = fread(golden, 1, sizeof(golden) - 1, file);
+			fclose(file);
+		}
+		if ((golden_len != len) || (memcmp(image, golden, len) != 0))
+		{
+			snprintf(path, sizeof(path), "%s.new.pbm", screens[idx].name);
+			file = fopen(path, "w");
+			if (file != NULL)
+			{
+				fwrite(image, 1, len, file);
+				fclose(file);
+			}
+			printf("FAIL: %s differs from the golden image, written to %s\n", screens[idx].name, path);
+			failed++;
+		}
+	}
+	if (update)
+	{
+		printf("%d golden images written to %s\n", (int)NUM_SCREENS, argv[1]);
+		return 0;
+	}
+	printf("Golden images: %d of %d match\n", (int)(NUM_SCREENS - failed), (int)NUM_SCREENS);
+
+	// Results that arrive while the display is off must be shown when it is switched on
+	uint16_t dark_failed = 0;
+	uint16_t dark_screens = 0;
+	for (uint8_t idx = 0; idx < NUM_SCREENS; idx++)
+	{
+		if (screens[idx].menu != S_SUB_NONE)
+		{
+			continue;
+		}
+		dark_screens++;
+		draw_screen(&screens[0]);
+		oled_power(false);
+		draw_screen(&screens[idx]);
+		oled_power(true);
+		size_t len = get_pbm(image);
+		char path[256];
+		snprintf(path, sizeof(path), "%s/%s.pbm", argv[1], screens[idx].name);
+		FILE *file = fopen(path, "r");
+		size_t golden_len = 0;
+		if (file != NULL)
+		{
+			golden_len = fread(golden, 1, sizeof(golden) - 1, file);
+			fclose(file);
+		}
+		// The display must have the framebuffer, another update sends nothing
+		uint32_t flushes;
+		uint32_t bytes;
+		uint32_t last_bytes;
+		uint32_t last_time;
+		oled_flush();
+		oled_get_stats(&flushes, &bytes, &last_bytes, &last_time);
+		if ((golden_len != len) || (memcmp(image, golden, len) != 0) || (last_bytes != 0))
+		{
+			printf("FAIL: %s drawn while the display was off is not shown after switching it on\n", screens[idx].name);
+			dark_failed++;
+		}
+	}
+	printf("Display off: %d of %d result screens shown on wake up\n", dark_screens - dark_failed, dark_screens);
+	failed += dark_failed;
+
+	// Render benchmark, a screen change costs the bytes of the changed columns
+	printf("%-24s %10s %10s\n", "Screen", "I2C bytes", "Render ns");
+	for (uint8_t idx = 0; idx < NUM_SCREENS; idx++)
+	{
+		uint32_t flushes;
+		uint32_t bytes;
+		uint32_t last_bytes;
+		uint32_t last_time;
+		// Start from the top menu, then measure the change to the screen
+		draw_screen(&screens[0]);
+		draw_screen(&screens[idx]);
+		oled_get_stats(&flushes, &bytes, &last_bytes, &last_time);
+		auto start = std::chrono::steady_clock::now();
+		for (uint16_t round = 0; round < BENCH_ROUNDS; round++)
+		{
+			draw_screen(&screens[idx]);
+		}
+		auto end = std::chrono::steady_clock::now();
+		double ns = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_ROUNDS;
+		printf("%-24s %10ld %10.0f\n", screens[idx].name, last_bytes, ns);
+	}
+	return failed == 0 ? 0 : 1;
+}
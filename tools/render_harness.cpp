@@ -0,0 +1,164 @@
+/**
+ * @file render_harness.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host harness for the display updates
+ *     Runs a scripted sequence of tests (join, LinkCheck results, failed uplinks,
+ *     Field Tester downlinks, button clicks in the settings UI) through the firmware and counts the display flushes
+ *     and I2C bytes of each phase. Fails if a timer callback draws into the
+ *     framebuffer or uses the I2C bus, this must only happen in the loop.
+ *     Build: make -C tools render_harness
+ *     Usage: render_harness
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+void setup(void);
+extern SFE_UBLOX_GNSS my_gnss;
+
+/** Test interval of the script in seconds */
+#define SCRIPT_INTERVAL 10
+/** Number of tests per phase */
+#define SCRIPT_TESTS 10
+
+/** Counters at the start of a phase */
+uint32_t phase_flushes = 0;
+uint32_t phase_oled_bytes = 0;
+uint32_t phase_wire_bytes = 0;
+
+/**
+ * @brief Start a phase of the script
+ *
+ */
+static void phase_start(void)
+{
+	uint32_t last_bytes;
+	uint32_t last_time;
+	oled_get_stats(&phase_flushes, &phase_oled_bytes, &last_bytes, &last_time);
+	phase_wire_bytes = Wire.bytes;
+}
+
+/**
+ * @brief Print the counters of a phase
+ *
+ * @param name name of the phase
+ * @param events number of events in the phase
+ */
+static void phase_end(const char *name, uint16_t events)
+{
+	uint32_t flushes;
+	uint32_t oled_bytes;
+	uint32_t last_bytes;
+	uint32_t last_time;
+	oled_get_stats(&flushes, &oled_bytes, &last_bytes, &last_time);
+	printf("%-14s %4d events %5ld flushes %8ld OLED bytes %8ld I2C bytes\n", name, events,
+		   flushes - phase_flushes, oled_bytes - phase_oled_bytes, Wire.bytes - phase_wire_bytes);
+}
+
+/**
+ * @brief Click the button, each edge goes through the interrupt handler
+ *
+ * @param clicks number of clicks
+ */
+static void click(uint8_t clicks)
+{
+	for (uint8_t idx = 0; idx < clicks; idx++)
+	{
+		digitalWrite(BUTTON_INT_PIN, LOW);
+		buttonIntHandle();
+		host_run(100);
+		digitalWrite(BUTTON_INT_PIN, HIGH);
+		buttonIntHandle();
+		host_run(100);
+	}
+	host_run(1000);
+}
+
+int main(int argc, char **argv)
+{
+	my_gnss.present = true;
+	setup();
+	host_run(1000);
+	phase_start();
+	phase_end("setup", 1);
+
+	// Join
+	phase_start();
+	api.lorawan.join_cb(0);
+	host_run(1000);
+	phase_end("join", 1);
+
+	// LinkCheck tests
+	phase_start();
+	host_at("ATC+SENDINT=10");
+	SERVICE_LORA_LINKCHECK_T link_check = {0};
+	for (uint16_t test = 0; test < SCRIPT_TESTS; test++)
+	{
+		host_run(SCRIPT_INTERVAL * 1000 - 500);
+		link_check.State = 0;
+		link_check.DemodMargin = 10 + test;
+		link_check.NbGateways = 1 + test % 3;
+		link_check.Rssi = -60 - 5 * test;
+		link_check.Snr = 8 - test;
+		api.lorawan.linkcheck_cb(&link_check);
+		host_run(500);
+	}
+	phase_end("linkcheck", SCRIPT_TESTS);
+
+	// Failed uplinks
+	phase_start();
+	for (uint16_t test = 0; test < SCRIPT_TESTS; test++)
+	{
+		host_run(SCRIPT_INTERVAL * 1000 - 500);
+		api.lorawan.send_cb(RAK_LORAMAC_STATUS_ERROR);
+		host_run(500);
+	}
+	phase_end("tx failed", SCRIPT_TESTS);
+
+	// Field Tester with GNSS fix and downlinks, the first fix needs some polls
+	phase_start();
+	my_gnss.fix_type = 0;
+	my_gnss.satellites = 9;
+	my_gnss.latitude = 143924570;
+	my_gnss.longitude = 1210155620;
+	my_gnss.hdop = 90;
+	g_custom_parameters.location_on = true;
+	host_at("ATC+MODE=2");
+	SERVICE_LORA_RECEIVE_T downlink = {0};
+	uint8_t payload[6] = {1, 110, 130, 2, 8, 2};
+	downlink.Port = 2;
+	downlink.Buffer = payload;
+	downlink.BufferSize = sizeof(payload);
+	for (uint16_t test = 0; test < SCRIPT_TESTS; test++)
+	{
+		host_run(SCRIPT_INTERVAL * 1000 - 500);
+		my_gnss.fix_type = 3;
+		downlink.Rssi = -70 - test;
+		downlink.Snr = 5;
+		api.lorawan.recv_cb(&downlink);
+		host_run(500);
+	}
+	phase_end("field tester", SCRIPT_TESTS);
+
+	// Settings UI, open it, go through the menus and close it
+	phase_start();
+	host_run(SCRIPT_INTERVAL * 1000);
+	click(2);
+	click(2);
+	click(1);
+	click(3);
+	click(1);
+	click(1);
+	phase_end("settings UI", 6);
+
+	printf("Timer callbacks: %ld I2C transfers, %ld framebuffer changes\n", Wire.timer_transfers, host_timer_draws);
+	if ((Wire.timer_transfers != 0) || (host_timer_draws != 0))
+	{
+		printf("FAIL: display or I2C bus used outside of the loop\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file status_bench.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host benchmark of the ATC+STATS response
+ *     Measures the time of status_line() and of the complete AT command in both
+ *     network modes and prints the length of the response. Then fills every
+ *     field with its widest value and checks that the line stays inside
+ *     STATUS_LINE_SIZE and the bytes behind the buffer are untouched.
+ *     Build: make -C tools status_bench
+ *     Usage: status_bench
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include <chrono>
+
+void setup(void);
+
+/** Number of benchmark rounds */
+#define BENCH_ROUNDS 10000
+/** Guard bytes behind the status buffer */
+#define GUARD_SIZE 64
+/** Value of the guard bytes */
+#define GUARD_BYTE 0xA5
+
+/** Status buffer followed by guard bytes */
+uint8_t status_buf[STATUS_LINE_SIZE + GUARD_SIZE];
+
+/**
+ * @brief Build the status line into the guarded buffer
+ *
+ * @return uint16_t length reported by status_line()
+ */
+static uint16_t guarded_status_line(void)
+{
+	memset(status_buf, GUARD_BYTE, sizeof(status_buf));
+	return status_line((char *)status_buf);
+}
+
+/**
+ * @brief Check the status line, length, terminator and guard bytes
+ *
+ * @param name name of the test
+ * @param len length reported by status_line()
+ * @return bool true if the line is valid
+ */
+static bool check_line(const char *name, uint16_t len)
+{
+	bool ok = true;
+	if ((len >= STATUS_LINE_SIZE) || (strlen((char *)status_buf) != len))
+	{
+		printf("FAIL: %s length %d, string length %d, buffer %d\n", name, len, (int)strnlen((char *)status_buf, STATUS_LINE_SIZE), STATUS_LINE_SIZE);
+		ok = false;
+	}
+	for (uint16_t idx = STATUS_LINE_SIZE; idx < sizeof(status_buf); idx++)
+	{
+		if (status_buf[idx] != GUARD_BYTE)
+		{
+			printf("FAIL: %s wrote behind the buffer at offset %d\n", name, idx);
+			ok = false;
+			break;
+		}
+	}
+	return ok;
+}
+
+/**
+ * @brief Measure status_line() and the complete AT command
+ *
+ * @param name name of the test
+ * @return bool true if the line is valid
+ */
+static bool bench(const char *name)
+{
+	// Refresh the radio snapshot outside of the measurement
+	status_invalidate();
+	uint16_t len = guarded_status_line();
+	bool ok = check_line(name, len);
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint16_t round = 0; round < BENCH_ROUNDS; round++)
+	{
+		status_line((char *)status_buf);
+	}
+	auto end = std::chrono::steady_clock::now();
+	double line_ns = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_ROUNDS;
+
+	start = std::chrono::steady_clock::now();
+	for (uint16_t round = 0; round < BENCH_ROUNDS; round++)
+	{
+		host_at("ATC+STATS=?");
+	}
+	end = std::chrono::steady_clock::now();
+	double at_ns = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_ROUNDS;
+
+	// Response is "ATC+STATS=" + line + CRLF
+	printf("%-10s %5d %8d %12.0f %12.0f\n", name, len, len + 12, line_ns, at_ns);
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	setup();
+	host_run(1000);
+	bool ok = true;
+
+	printf("%-10s %5s %8s %12s %12s\n", "Mode", "Line", "Response", "Line ns", "AT ns");
+	api.lorawan.nwm.set(1);
+	ok &= bench("LoRaWAN");
+	api.lorawan.nwm.set(0);
+	ok &= bench("LoRa P2P");
+
+	// Widest value of every field, the packet length is limited to 128 by the settings
+	g_custom_parameters.test_mode = 255;
+	g_custom_parameters.send_interval = 0xFFFFFFFF;
+	g_custom_parameters.display_saver = true;
+	g_custom_parameters.send_distance = 65535;
+	g_custom_parameters.custom_packet_len = 128;
+	api.lora.pfreq.set(0xFFFFFFFF);
+	packet_num = INT32_MIN;
+	packet_lost = INT32_MIN;
+	last_rssi = INT16_MIN;
+	last_snr = INT8_MIN;
+	last_dr = 255;
+	link_check_gateways = 255;
+	link_check_demod_margin = 255;
+	tx_fail_status = INT32_MIN;
+	g_battery_mv = 65535;
+	g_battery_soc = 255;
+	g_log_count = 65535;
+	g_grid_used = 65535;
+	g_last_satellites = 255;
+	g_last_lat = INT32_MIN;
+	g_last_long = INT32_MIN;
+	ok &= bench("Worst P2P");
+	api.lorawan.nwm.set(1);
+	ok &= bench("Worst WAN");
+
+	return ok ? 0 : 1;
+}
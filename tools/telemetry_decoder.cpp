@@ -0,0 +1,147 @@
+/**
+ * @file telemetry_decoder.cpp
+ * @author Bernd Giesecke (bernd@giesecke.tk)
+ * @brief Host tool, converts the binary telemetry stream (ATC+TLM=1) to CSV
+ *     Build: g++ -O2 -o telemetry_decoder telemetry_decoder.cpp
+ *     Usage: telemetry_decoder < /dev/ttyACM0 > results.csv
+ *     Text (AT responses) between the frames is ignored
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+/** Size of a telemetry record including the CRC */
+#define TLM_RECORD_SIZE 28
+
+/**
+ * @brief Calculate CRC16 (CCITT, polynom 0x1021, start 0xFFFF), same as on the device
+ *
+ * @param data data buffer
+ * @param len length of the data
+ * @return uint16_t CRC of the data
+ */
+static uint16_t crc16(const uint8_t *data, uint16_t len)
+{
+	uint16_t crc = 0xFFFF;
+	for (uint16_t idx = 0; idx < len; idx++)
+	{
+		crc ^= (uint16_t)data[idx] << 8;
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+/**
+ * @brief COBS decode a frame (without the 0x00 delimiter)
+ *
+ * @param src encoded frame
+ * @param len length of the frame
+ * @param dst buffer for the decoded data
+ * @param max size of the buffer
+ * @return int length of the decoded data, -1 if the frame is invalid
+ */
+static int cobs_decode(const uint8_t *src, int len, uint8_t *dst, int max)
+{
+	int dst_idx = 0;
+	int idx = 0;
+	while (idx < len)
+	{
+		uint8_t code = src[idx++];
+		if ((code == 0) || (idx + code - 1 > len))
+		{
+			return -1;
+		}
+		for (int copy = 1; copy < code; copy++)
+		{
+			if (dst_idx >= max)
+			{
+				return -1;
+			}
+			dst[dst_idx++] = src[idx++];
+		}
+		if ((code < 0xFF) && (idx < len))
+		{
+			if (dst_idx >= max)
+			{
+				return -1;
+			}
+			dst[dst_idx++] = 0;
+		}
+	}
+	return dst_idx;
+}
+
+/**
+ * @brief Get a little endian value from the record
+ *
+ * @param data pointer to the first byte
+ * @param bytes number of bytes
+ * @return uint32_t value
+ */
+static uint32_t get_le(const uint8_t *data, int bytes)
+{
+	uint32_t value = 0;
+	for (int idx = bytes - 1; idx >= 0; idx--)
+	{
+		value = (value << 8) | data[idx];
+	}
+	return value;
+}
+
+int main(void)
+{
+	uint8_t frame[TLM_RECORD_SIZE + 1];
+	uint8_t tlm[TLM_RECORD_SIZE];
+	int frame_len = 0;
+	int bad_frames = 0;
+	int in;
+
+	printf("event,seq,time,mode,rssi,snr,margin,gateways,lat,lon,battery_mv,battery_soc\n");
+	while ((in = getchar()) != EOF)
+	{
+		if (in != 0)
+		{
+			// Keep only the last bytes, text before the frame is dropped
+			if (frame_len == (int)sizeof(frame))
+			{
+				memmove(frame, &frame[1], sizeof(frame) - 1);
+				frame_len--;
+			}
+			frame[frame_len++] = (uint8_t)in;
+			continue;
+		}
+		// A frame is the COBS encoded record with 1 overhead byte
+		if (frame_len == (int)sizeof(frame))
+		{
+			if ((cobs_decode(frame, sizeof(frame), tlm, TLM_RECORD_SIZE) == TLM_RECORD_SIZE) &&
+				(crc16(tlm, TLM_RECORD_SIZE - 2) == get_le(&tlm[26], 2)))
+			{
+				int32_t lat = (int32_t)get_le(&tlm[15], 4);
+				int32_t lon = (int32_t)get_le(&tlm[19], 4);
+				printf("%u,%u,%u,%u,%d,%d,%d,%u,%.7f,%.7f,%u,%u\n",
+					   tlm[0], get_le(&tlm[1], 4), get_le(&tlm[5], 4), tlm[9],
+					   (int16_t)get_le(&tlm[10], 2), (int8_t)tlm[12], (int8_t)tlm[13], tlm[14],
+					   lat / 10000000.0, lon / 10000000.0, get_le(&tlm[23], 2), tlm[25]);
+				fflush(stdout);
+			}
+			else
+			{
+				bad_frames++;
+			}
+		}
+		frame_len = 0;
+	}
+	if (bad_frames != 0)
+	{
+		fprintf(stderr, "%d invalid frames\n", bad_frames);
+	}
+	return 0;
+}